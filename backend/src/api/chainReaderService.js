@@ -58,7 +58,7 @@ export class ChainReaderService {
         const result = await this.getTableRows({
             code: this.contractAccount,
             scope: account,
-            table: 'likes',
+            table: 'likes2',
             limit,
             reverse: true
         });
@@ -74,7 +74,7 @@ export class ChainReaderService {
         const result = await this.getTableRows({
             code: this.contractAccount,
             scope: this.contractAccount,
-            table: 'votetally',
+            table: 'votetally2',
             lower_bound: String(anchorId),
             upper_bound: String(anchorId),
             limit: 1
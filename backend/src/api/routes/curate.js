@@ -11,8 +11,42 @@
  */
 
 import express from 'express';
+import { APIClient, Action, Transaction } from '@wharfkit/antelope';
 import { sanitizeError } from '../../utils/errorSanitizer.js';
 
+/** @type {Map<string, Object>} "rpcUrl|account" -> contract ABI */
+const abiCache = new Map();
+
+/**
+ * Run a contract's read-only action through send_read_only_transaction
+ * and return its decoded result. The contract resolves hash-derived keys
+ * itself, so callers never re-derive them.
+ *
+ * @param {string} rpcUrl
+ * @param {string} account - Contract account
+ * @param {string} name - Read-only action name
+ * @param {Object} data - Action arguments
+ * @returns {Promise<Object>}
+ */
+async function readOnlyAction(rpcUrl, account, name, data) {
+    const client = new APIClient({ url: rpcUrl });
+    const cacheKey = `${rpcUrl}|${account}`;
+    let abi = abiCache.get(cacheKey);
+    const [info, abiResponse] = await Promise.all([
+        client.v1.chain.get_info(),
+        abi ? null : client.v1.chain.get_abi(account)
+    ]);
+    if (!abi) {
+        abi = abiResponse.abi;
+        abiCache.set(cacheKey, abi);
+    }
+
+    const action = Action.from({ account, name, authorization: [], data }, abi);
+    const transaction = Transaction.from({ ...info.getTransactionHeader(), actions: [action] });
+    const result = await client.v1.chain.send_read_only_transaction(transaction);
+    return result.processed.action_traces[0].return_value_data;
+}
+
 /**
  * Parse type-specific detail from a stored event payload for rendering.
  * Pure function: returns a structured object the frontend can render
@@ -142,11 +176,11 @@ export function createCurateRoutes({ store, config }) {
     /**
      * GET /api/curate/operations
      * Get recent anchored operations with on-chain vote tallies.
-     * Reads anchors + votetally tables from the blockchain.
+     * Reads anchors + anchorstate + votetally tables from the blockchain.
      *
      * Query params:
      *   limit (default 50)
-     *   lower_bound (anchor id for pagination)
+     *   lower_bound (anchor seq for pagination)
      *   type (filter by event type)
      */
     router.get('/operations', async (req, res) => {
@@ -165,7 +199,9 @@ export function createCurateRoutes({ store, config }) {
                 json: true,
                 code: contractAccount,
                 scope: contractAccount,
-                table: 'anchors',
+                table: 'anchors2',
+                index_position: 3, // byseq (anchor ids are hash-derived, not sequential)
+                key_type: 'i64',
                 limit,
                 reverse: true // newest first
             };
@@ -186,14 +222,39 @@ export function createCurateRoutes({ store, config }) {
                 rows = rows.filter(r => r.type === filterType);
             }
 
-            // Fetch tallies for each anchor
+            // Fetch settlement state and tallies for each anchor
             const operations = [];
             for (const anchor of rows) {
+                const stateBody = {
+                    json: true,
+                    code: contractAccount,
+                    scope: contractAccount,
+                    table: 'anchorstate',
+                    limit: 1,
+                    lower_bound: String(anchor.id),
+                    upper_bound: String(anchor.id)
+                };
+
+                let state = null;
+                try {
+                    const stateResp = await fetch(`${rpcUrl}/v1/chain/get_table_rows`, {
+                        method: 'POST',
+                        headers: { 'Content-Type': 'application/json' },
+                        body: JSON.stringify(stateBody)
+                    });
+                    if (stateResp.ok) {
+                        const stateData = await stateResp.json();
+                        state = stateData.rows && stateData.rows[0] || null;
+                    }
+                } catch (e) {
+                    // State fetch failure is non-fatal
+                }
+
                 const tallyBody = {
                     json: true,
                     code: contractAccount,
                     scope: contractAccount,
-                    table: 'votetally',
+                    table: 'votetally2',
                     limit: 1,
                     lower_bound: String(anchor.id),
                     upper_bound: String(anchor.id)
@@ -236,8 +297,8 @@ export function createCurateRoutes({ store, config }) {
                     hash: anchor.hash,
                     event_cid: anchor.event_cid,
                     ts: anchor.ts,
-                    expires_at: anchor.expires_at,
-                    finalized: anchor.finalized ? true : false,
+                    expires_at: state ? state.expires_at : null,
+                    finalized: state && state.finalized ? true : false,
                     tally: tally ? {
                         up_weight: parseInt(tally.up_weight) || 0,
                         down_weight: parseInt(tally.down_weight) || 0,
@@ -273,56 +334,31 @@ export function createCurateRoutes({ store, config }) {
             }
 
             const contractAccount = process.env.CONTRACT_ACCOUNT || 'polaris';
-            const hash = req.params.hash;
-
-            // Fetch anchor by hash (secondary index)
-            const anchorsResp = await fetch(`${rpcUrl}/v1/chain/get_table_rows`, {
-                method: 'POST',
-                headers: { 'Content-Type': 'application/json' },
-                body: JSON.stringify({
-                    json: true,
-                    code: contractAccount,
-                    scope: contractAccount,
-                    table: 'anchors',
-                    index_position: 2, // byhash
-                    key_type: 'sha256',
-                    lower_bound: hash,
-                    upper_bound: hash,
-                    limit: 1
-                })
-            });
-            if (!anchorsResp.ok) throw new Error(`Chain RPC error: ${anchorsResp.status}`);
-            const anchorsData = await anchorsResp.json();
-
-            if (!anchorsData.rows || anchorsData.rows.length === 0) {
-                return res.status(404).json({ success: false, error: 'Anchor not found' });
+            const hash = req.params.hash.toLowerCase();
+            if (!/^[0-9a-f]{64}$/.test(hash)) {
+                return res.status(400).json({ success: false, error: 'Invalid hash' });
             }
 
-            const anchor = anchorsData.rows[0];
-
-            // Fetch tally
-            let tally = null;
+            // Anchor metadata, settlement state and tally in one read-only call
+            let view;
             try {
-                const tallyResp = await fetch(`${rpcUrl}/v1/chain/get_table_rows`, {
-                    method: 'POST',
-                    headers: { 'Content-Type': 'application/json' },
-                    body: JSON.stringify({
-                        json: true,
-                        code: contractAccount,
-                        scope: contractAccount,
-                        table: 'votetally',
-                        limit: 1,
-                        lower_bound: String(anchor.id),
-                        upper_bound: String(anchor.id)
-                    })
-                });
-                if (tallyResp.ok) {
-                    const tallyData = await tallyResp.json();
-                    tally = tallyData.rows?.[0] || null;
+                view = await readOnlyAction(rpcUrl, contractAccount, 'getanchor', { tx_hash: hash });
+            } catch (e) {
+                if (/Anchor not found/.test(e.message)) {
+                    return res.status(404).json({ success: false, error: 'Anchor not found' });
                 }
-            } catch (e) { /* non-fatal */ }
+                throw e;
+            }
+            const anchor = {
+                id: view.anchor_id,
+                hash: view.hash,
+                type: view.type,
+                author: view.author,
+                ts: view.ts,
+                event_cid: view.event_cid
+            };
 
-            // Fetch individual votes for this hash
+            // Fetch individual votes (votes are scoped by anchor id)
             let votes = [];
             try {
                 const votesResp = await fetch(`${rpcUrl}/v1/chain/get_table_rows`, {
@@ -331,12 +367,8 @@ export function createCurateRoutes({ store, config }) {
                     body: JSON.stringify({
                         json: true,
                         code: contractAccount,
-                        scope: contractAccount,
-                        table: 'votes',
-                        index_position: 3, // byhash
-                        key_type: 'sha256',
-                        lower_bound: hash,
-                        upper_bound: hash,
+                        scope: String(view.anchor_id),
+                        table: 'votes2',
                         limit: 200
                     })
                 });
@@ -381,16 +413,15 @@ export function createCurateRoutes({ store, config }) {
                     type_name: typeNames[typeCode] || `TYPE_${typeCode}`,
                     author: anchor.author || eventPayload?.author || null,
                     ts: anchor.ts || null,
-                    finalized: !!anchor.finalized,
+                    finalized: !!view.finalized,
                     event_cid: anchor.event_cid || null
                 },
-                tally: tally ? {
-                    up_weight: parseInt(tally.up_weight) || 0,
-                    down_weight: parseInt(tally.down_weight) || 0,
-                    up_voter_count: parseInt(tally.up_voter_count) || 0,
-                    down_voter_count: parseInt(tally.down_voter_count) || 0,
-                    updated_at: tally.updated_at
-                } : { up_weight: 0, down_weight: 0, up_voter_count: 0, down_voter_count: 0 },
+                tally: {
+                    up_weight: parseInt(view.up_weight) || 0,
+                    down_weight: parseInt(view.down_weight) || 0,
+                    up_voter_count: parseInt(view.up_voter_count) || 0,
+                    down_voter_count: parseInt(view.down_voter_count) || 0
+                },
                 viewer_vote: viewerVote,
                 votes: votes.map(v => ({
                     voter: v.voter,
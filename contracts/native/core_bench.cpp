@@ -0,0 +1,98 @@
+/**
+ * @file core_bench.cpp
+ * @brief Microbenchmarks for polaris.core.hpp
+ *
+ *   core_bench [iterations]
+ *
+ * Prints one "name ns/op" line per routine. Native timings are only a
+ * relative measure of the arithmetic; on-chain CPU is measured by
+ * test/benchmark.js.
+ */
+
+#include "polaris.core.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace polaris_core;
+
+namespace {
+
+// Keeps results alive so the loops are not optimized away
+volatile uint64_t sink;
+
+template<typename Fn>
+void bench(const char* name, long iterations, Fn&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    uint64_t acc = 0;
+    for (long i = 0; i < iterations; ++i) {
+        acc += fn(static_cast<uint64_t>(i));
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    sink = acc;
+
+    double ns = std::chrono::duration<double, std::nano>(elapsed).count() / iterations;
+    std::printf("%-28s %8.2f ns/op\n", name, ns);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    long iterations = argc > 1 ? std::atol(argv[1]) : 2000000;
+
+    bench("log2_q32", iterations, [](uint64_t i) {
+        return log2_q32(i + 2);
+    });
+
+    bench("emission_q32", iterations, [](uint64_t i) {
+        return static_cast<uint64_t>(emission_q32(100000000, i + 2));
+    });
+
+    uint64_t carry = 0;
+    bench("mint_with_carry", iterations, [&carry](uint64_t i) {
+        mint_result r = mint_with_carry(1000000, i + 2, carry);
+        carry = r.carry_q32;
+        return r.mint;
+    });
+
+    tally_weights t;
+    bench("tally_add+tally_remove", iterations, [&t](uint64_t i) {
+        // Vote change: remove the previous contribution, add the new one
+        int8_t old_val = (i & 1) ? -1 : 1;
+        int8_t val = (i & 2) ? 1 : -1;
+        tally_remove(t, old_val, static_cast<uint32_t>(i % 50));
+        tally_add(t, val, static_cast<uint32_t>(i % 100) + 1);
+        return t.up_weight + t.down_voter_count;
+    });
+
+    bench("is_accepted", iterations, [](uint64_t i) {
+        return static_cast<uint64_t>(is_accepted(i * 7, i * 3 + 1, 9000));
+    });
+
+    bench("bp_share+split_equally", iterations, [](uint64_t i) {
+        uint64_t voters = bp_share(i * 1000003, 5000);
+        equal_split s = split_equally(voters, static_cast<uint32_t>(i % 97) + 1);
+        return s.share + s.remainder;
+    });
+
+    uint128 rps = 0;
+    bench("stake accumulator", iterations, [&rps](uint64_t i) {
+        rps += reward_per_stake_increment(i + 1, 1000000000);
+        return accrued_reward(static_cast<int64_t>(i % 50000) + 1, rps, rps >> 1);
+    });
+
+    uint8_t hash[32];
+    for (int i = 0; i < 32; ++i) hash[i] = static_cast<uint8_t>(i * 31 + 7);
+    bench("hash_prefix+combine_keys", iterations, [&hash](uint64_t i) {
+        hash[0] = static_cast<uint8_t>(i);
+        return static_cast<uint64_t>(combine_keys(i, hash_prefix(hash)) >> 32);
+    });
+
+    bench("to_hex(32 bytes)", iterations / 10, [&hash](uint64_t i) {
+        hash[1] = static_cast<uint8_t>(i);
+        return static_cast<uint64_t>(to_hex(hash, 32)[2]);
+    });
+
+    return 0;
+}
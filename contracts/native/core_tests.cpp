@@ -0,0 +1,246 @@
+/**
+ * @file core_tests.cpp
+ * @brief Known-answer tests for polaris.core.hpp
+ *
+ * The emission vectors match the BigInt mirror in
+ * test/unit/validation.test.js, so the WASM contract, the native build
+ * and the JS reference all agree on the same numbers.
+ */
+
+#include "polaris.core.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <map>
+
+using namespace polaris_core;
+
+static int failures = 0;
+
+#define CHECK(cond)                                                        \
+    do {                                                                   \
+        if (!(cond)) {                                                     \
+            std::fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__,    \
+                         __LINE__, #cond);                                 \
+            ++failures;                                                    \
+        }                                                                  \
+    } while (0)
+
+static void test_log2() {
+    CHECK(log2_q32(1) == 0);
+    CHECK(log2_q32(2) == (uint64_t(1) << 32));
+    CHECK(log2_q32(1024) == (uint64_t(10) << 32));
+    CHECK(log2_q32(uint64_t(1) << 40) == (uint64_t(40) << 32));
+    CHECK(log2_q32(3) == 6807362105ULL);
+    CHECK(log2_q32(10) == 14267572527ULL);
+    CHECK(log2_q32(12345) == 58375645931ULL);
+    CHECK(log2_q32(UINT64_MAX) == 274877906943ULL);
+}
+
+static void test_emission() {
+    CHECK(emission_q32(1000000, 1) == 0);
+    CHECK(emission_q32(1000000, 2) == uint128(1488522235500000ULL));
+    CHECK(emission_q32(1000000, 3) == uint128(1572834616666666ULL));
+    CHECK(emission_q32(100000000, 12345) == uint128(327767633778857ULL));
+    CHECK(emission_q32(1000, 987654321) == uint128(90064));
+
+    // Carry: mints over a run sum to the truncated total
+    uint64_t carry = 0;
+    uint128 minted = 0;
+    uint128 exact = 0;
+    for (uint64_t x = 2; x < 200; ++x) {
+        mint_result r = mint_with_carry(50000, x, carry);
+        minted += r.mint;
+        carry = r.carry_q32;
+        exact += emission_q32(50000, x);
+    }
+    CHECK(minted == (exact >> 32));
+
+    // A carry holding whole units (legacy fold) is minted, not dropped
+    mint_result folded = mint_with_carry(0, 2, (uint64_t(3) << 32) | 5);
+    CHECK(folded.mint == 3 && folded.carry_q32 == 5);
+
+    // Clamp keeps the mint within uint64_t
+    mint_result capped = mint_with_carry(UINT64_MAX, 3, Q32_FRACTION_MASK);
+    CHECK(capped.mint == 10000000000000000ULL);
+    CHECK(capped.carry_q32 == 0);
+}
+
+static void test_tally() {
+    tally_weights t;
+    tally_add(t, 1, 40);
+    tally_add(t, 1, 10);
+    tally_add(t, -1, 5);
+    tally_add(t, 0, 99);
+    CHECK(t.up_weight == 50 && t.up_voter_count == 2);
+    CHECK(t.down_weight == 5 && t.down_voter_count == 1);
+
+    tally_remove(t, 1, 10);
+    CHECK(t.up_weight == 40 && t.up_voter_count == 1);
+
+    // Underflow-safe
+    tally_remove(t, -1, 50);
+    tally_remove(t, -1, 50);
+    CHECK(t.down_weight == 0 && t.down_voter_count == 0);
+
+    CHECK(!is_accepted(0, 0, 9000));
+    CHECK(is_accepted(90, 10, 9000));
+    CHECK(!is_accepted(89, 11, 9000));
+    CHECK(is_accepted(UINT64_MAX, 0, 10000));
+}
+
+static void test_distribution() {
+    CHECK(bp_share(1000, 5000) == 500);
+    CHECK(bp_share(10001, 5000) == 5000);
+    // No 64-bit overflow at the mint cap
+    CHECK(bp_share(10000000000000000ULL, 9999) == 9999000000000000ULL);
+
+    equal_split s = split_equally(100, 3);
+    CHECK(s.share == 33 && s.remainder == 1);
+    s = split_equally(2, 3);
+    CHECK(s.share == 0 && s.remainder == 2);
+    s = split_equally(50, 0);
+    CHECK(s.share == 0 && s.remainder == 50);
+
+    CHECK(reward_per_stake_increment(100, 0) == 0);
+    uint128 rps = reward_per_stake_increment(1000, 4000);
+    CHECK(rps == REWARD_PRECISION / 4);
+    CHECK(accrued_reward(1000, rps, 0) == 250);
+    CHECK(accrued_reward(3000, rps, 0) == 750);
+    CHECK(accrued_reward(3000, rps, rps) == 0);
+    CHECK(accrued_reward(0, rps, 0) == 0);
+}
+
+static void test_respect() {
+    // Staged for round 4 while round 3 is committed
+    CHECK(effective_respect(40, 70, 4, 3) == 40);
+    CHECK(effective_respect(40, 70, 4, 4) == 70);
+    // Not listed again in round 5: the staged value stays in effect
+    CHECK(effective_respect(40, 70, 4, 5) == 70);
+    // Nothing staged
+    CHECK(effective_respect(40, 0, 0, 9) == 40);
+    // Member added by a staged epoch has no Respect before commit
+    CHECK(effective_respect(0, 25, 6, 5) == 0);
+    CHECK(effective_respect(0, 25, 6, 6) == 25);
+}
+
+static void test_keys() {
+    uint8_t hash[32];
+    for (int i = 0; i < 32; ++i) hash[i] = static_cast<uint8_t>(i * 17);
+    CHECK(hash_prefix(hash) == 0x0011223344556677ULL);
+    CHECK(combine_keys(5, hash_prefix(hash)) == ((uint128(5) << 64) | 0x0011223344556677ULL));
+    CHECK(hash_slot(0x0011223344556677ULL, 2) == 0x0011223344556679ULL);
+    CHECK(hash_slot(0xFFFFFFFFFFFFFFFFULL, 0) == OVERFLOW_KEY_BASE - 1);
+    CHECK(hash_slot(0xFFFFFFFFFFFFFFFFULL, 1) == 0);
+
+    std::string hex = to_hex(hash, 4);
+    CHECK(hex == "00112233");
+    CHECK(to_hex(hash, 32).size() == 64);
+}
+
+// Rows of a hash-keyed table (key -> hash) and its hashoverflow entries (hash -> key)
+struct probe_table {
+    std::map<uint64_t, uint64_t> rows;
+    std::map<uint64_t, uint64_t> overflow;
+
+    window_probe scan(uint64_t prefix, uint64_t hash) const {
+        return probe_window(prefix, [&](uint64_t key) {
+            auto itr = rows.find(key);
+            if (itr == rows.end()) return slot_state::empty;
+            return itr->second == hash ? slot_state::match : slot_state::other;
+        });
+    }
+
+    uint64_t available_primary_key() const {
+        return rows.empty() ? 0 : rows.rbegin()->first + 1;
+    }
+
+    // Same decisions as polaris::probe_hash_key followed by emplace
+    uint64_t insert(uint64_t prefix, uint64_t hash) {
+        window_probe p = scan(prefix, hash);
+        uint64_t key = p.has_free ? p.free_key : overflow_key(available_primary_key());
+        if (!p.has_free) overflow[hash] = key;
+        rows[key] = hash;
+        return key;
+    }
+};
+
+static void test_probe() {
+    const uint64_t prefix = 0x2AAAAAAAAAAAAAAAULL;
+    probe_table t;
+
+    // Colliding prefixes take consecutive slots and each is found again
+    CHECK(t.insert(prefix, 1) == prefix);
+    CHECK(t.insert(prefix, 2) == prefix + 1);
+    window_probe p = t.scan(prefix, 2);
+    CHECK(p.found && p.key == prefix + 1);
+    CHECK(!t.scan(prefix, 9).found);
+    CHECK(t.scan(prefix, 9).has_free && t.scan(prefix, 9).free_key == prefix + 2);
+
+    // A slot freed ahead of a row does not hide it
+    t.rows.erase(prefix);
+    p = t.scan(prefix, 2);
+    CHECK(p.found && p.key == prefix + 1);
+    CHECK(p.has_free && p.free_key == prefix);
+
+    // Window of HASH_PROBE_WINDOW slots, then the overflow range
+    t.rows.clear();
+    for (uint64_t h = 1; h <= HASH_PROBE_WINDOW; ++h) t.insert(prefix, h);
+    p = t.scan(prefix, 99);
+    CHECK(!p.found && !p.has_free);
+    CHECK(t.insert(prefix, 99) == OVERFLOW_KEY_BASE);
+    CHECK(t.overflow[99] == OVERFLOW_KEY_BASE);
+    CHECK(t.insert(prefix, 100) == OVERFLOW_KEY_BASE + 1);
+    // Overflow rows are never matched by the window scan
+    CHECK(!t.scan(prefix, 99).found);
+
+    // The window wraps below OVERFLOW_KEY_BASE
+    probe_table w;
+    const uint64_t top = OVERFLOW_KEY_BASE - 2;
+    for (uint64_t h = 1; h <= HASH_PROBE_WINDOW; ++h) w.insert(top, h);
+    CHECK(w.rows.count(top) && w.rows.count(top + 1) && w.rows.count(0) && w.rows.count(1));
+
+    CHECK(overflow_key(0) == OVERFLOW_KEY_BASE);
+    CHECK(overflow_key(OVERFLOW_KEY_BASE - 1) == OVERFLOW_KEY_BASE);
+    CHECK(overflow_key(OVERFLOW_KEY_BASE + 7) == OVERFLOW_KEY_BASE + 7);
+}
+
+static void test_event_types() {
+    int valid = 0;
+    for (int code = 0; code < 256; ++code) {
+        const event_policy& p = policy_of(static_cast<uint8_t>(code));
+        if (p.valid) ++valid;
+        // Only valid content types emit, and invalid codes carry no policy
+        if (p.emits()) CHECK(p.valid && p.content);
+        if (!p.valid) CHECK(!p.votable && !p.content);
+    }
+    CHECK(valid == MAX_EVENT_TYPE - MIN_EVENT_TYPE + 1);
+
+    CHECK(policy_of(21).window == window_slot::release && policy_of(21).multiplier == multiplier_slot::release);
+    CHECK(policy_of(30).window == window_slot::claim && policy_of(31).window == window_slot::claim);
+    CHECK(policy_of(31).multiplier == multiplier_slot::edit_claim);
+    CHECK(policy_of(99).window == window_slot::standard && !policy_of(99).emits());
+    CHECK(policy_of(25).content && !policy_of(25).emits());
+    // Activity records are rejected by vote(); MERGE_ENTITY stays votable outside the content range
+    CHECK(!policy_of(40).votable && !policy_of(41).votable && !policy_of(42).votable);
+    CHECK(policy_of(50).valid && !policy_of(50).votable);
+    CHECK(policy_of(60).votable && !policy_of(60).content && !policy_of(60).emits());
+}
+
+int main() {
+    test_log2();
+    test_emission();
+    test_tally();
+    test_distribution();
+    test_respect();
+    test_keys();
+    test_probe();
+    test_event_types();
+
+    if (failures) {
+        std::fprintf(stderr, "%d check(s) failed\n", failures);
+        return 1;
+    }
+    std::printf("core_tests: all checks passed\n");
+    return 0;
+}
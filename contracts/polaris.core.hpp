@@ -0,0 +1,394 @@
+/**
+ * @file polaris.core.hpp
+ * @brief Pure arithmetic of the Polaris Music Registry contract
+ *
+ * Header-only and free of eosio dependencies, so the same code is compiled
+ * into the WASM contract (polaris.music.cpp) and into the native tests,
+ * microbenchmarks and fuzz harness under native/. Everything here is
+ * integer-only and deterministic.
+ *
+ * - Emission curve g(x) = m * ln(x) / x in Q32.32 fixed point
+ * - Vote tally contributions and the approval threshold
+ * - Reward splits: basis-point shares, equal voter shares, staker accumulator
+ * - Staged Respect selection
+ * - Key derivation (hash prefix, probe window, composite keys) and hex encoding
+ * - Event-type policy registry (validity, emission, voting, window)
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace polaris_core {
+
+using uint128 = unsigned __int128;
+
+// ln(2) in Q0.64 and the fractional mask of Q32.32 values (see emission_q32)
+constexpr uint64_t LN2_Q64 = 12786308645202655659ULL;
+constexpr uint64_t Q32_FRACTION_MASK = 0xFFFFFFFFULL;
+
+// Upper bound of one anchor's mint with carry, in Q32.32 (1 trillion * 10000 units)
+constexpr uint128 MAX_MINT_Q32 = uint128(10000000000000000ULL) << 32;
+
+// Fixed-point scale of the staker reward accumulator (1e18)
+constexpr uint128 REWARD_PRECISION = 1000000000000000000ULL;
+
+// Distribution ratios and the approval threshold are in basis points
+constexpr uint64_t BASIS_POINTS = 10000;
+
+// ============ EMISSION ============
+
+/**
+ * @brief log2(x) in Q32.32 fixed point, for x >= 1
+ *
+ * Integer part from the highest set bit; fractional bits by repeated
+ * squaring of the normalized mantissa (one bit per squaring).
+ */
+inline uint64_t log2_q32(uint64_t x) {
+    uint64_t int_part = 63 - static_cast<uint64_t>(__builtin_clzll(x));
+
+    // Mantissa x / 2^int_part in [1, 2), as Q1.63
+    uint128 y = uint128(x) << (63 - int_part);
+    uint64_t frac = 0;
+    for (int i = 31; i >= 0; --i) {
+        y = (y * y) >> 63;               // Square: [1, 4)
+        if (y >= (uint128(1) << 64)) {   // >= 2: emit a 1 bit and renormalize
+            y >>= 1;
+            frac |= uint64_t(1) << i;
+        }
+    }
+    return (int_part << 32) | frac;
+}
+
+/**
+ * @brief Emission curve g(x) = m * ln(x) / x in Q32.32 fixed point, for x >= 1
+ *
+ * ln(x) = log2(x) * ln(2), with ln(2) in Q0.64. Results are truncated,
+ * never rounded up, so the sum of mints can only trail the real curve.
+ */
+inline uint128 emission_q32(uint64_t multiplier, uint64_t x) {
+    uint128 ln_q32 = (uint128(log2_q32(x)) * LN2_Q64) >> 64;
+    return (uint128(multiplier) * ln_q32) / x;
+}
+
+/**
+ * @brief Whole units to mint for one submission and the carry left over
+ */
+struct mint_result {
+    uint64_t mint;
+    uint64_t carry_q32;
+};
+
+/**
+ * @brief Add g(x) to the fractional carry and split off whole units
+ *
+ * The total is clamped to MAX_MINT_Q32 before the split.
+ */
+inline mint_result mint_with_carry(uint64_t multiplier, uint64_t x, uint64_t carry_q32) {
+    uint128 total_with_carry = emission_q32(multiplier, x) + carry_q32;
+    if (total_with_carry > MAX_MINT_Q32) {
+        total_with_carry = MAX_MINT_Q32;
+    }
+    return mint_result{static_cast<uint64_t>(total_with_carry >> 32),
+                       static_cast<uint64_t>(total_with_carry) & Q32_FRACTION_MASK};
+}
+
+// ============ TALLY ============
+
+/**
+ * @brief Aggregate vote weights (same field names as the votetally row)
+ */
+struct tally_weights {
+    uint64_t up_weight = 0;
+    uint64_t down_weight = 0;
+    uint32_t up_voter_count = 0;
+    uint32_t down_voter_count = 0;
+};
+
+/**
+ * @brief Add a vote's contribution to a tally (row or tally_weights)
+ */
+template<typename Tally>
+inline void tally_add(Tally& t, int8_t val, uint32_t weight) {
+    if (val == 1) {
+        t.up_weight += weight;
+        t.up_voter_count += 1;
+    } else if (val == -1) {
+        t.down_weight += weight;
+        t.down_voter_count += 1;
+    }
+}
+
+/**
+ * @brief Remove a vote's contribution from a tally (underflow-safe)
+ */
+template<typename Tally>
+inline void tally_remove(Tally& t, int8_t old_val, uint32_t old_weight) {
+    if (old_val == 1) {
+        t.up_weight = (t.up_weight >= old_weight) ? t.up_weight - old_weight : 0;
+        t.up_voter_count = (t.up_voter_count > 0) ? t.up_voter_count - 1 : 0;
+    } else if (old_val == -1) {
+        t.down_weight = (t.down_weight >= old_weight) ? t.down_weight - old_weight : 0;
+        t.down_voter_count = (t.down_voter_count > 0) ? t.down_voter_count - 1 : 0;
+    }
+}
+
+/**
+ * @brief Approval check in integer basis points
+ *
+ * Accepted when at least one vote was cast and
+ * up / (up + down) >= threshold_bp / 10000.
+ */
+inline bool is_accepted(uint64_t up_weight, uint64_t down_weight, uint64_t threshold_bp) {
+    uint128 total = uint128(up_weight) + down_weight;
+    return total > 0 && uint128(up_weight) * BASIS_POINTS >= total * threshold_bp;
+}
+
+// ============ DISTRIBUTION ============
+
+/**
+ * @brief total * bp / 10000, computed without 64-bit overflow
+ */
+inline uint64_t bp_share(uint64_t total, uint64_t bp) {
+    return static_cast<uint64_t>((uint128(total) * bp) / BASIS_POINTS);
+}
+
+/**
+ * @brief Equal split of an amount among voters
+ */
+struct equal_split {
+    uint64_t share;      // Per voter (0 = nothing distributed)
+    uint64_t remainder;  // Left undistributed
+};
+
+inline equal_split split_equally(uint64_t total, uint32_t count) {
+    if (total == 0 || count == 0) return equal_split{0, total};
+    uint64_t share = total / count;
+    if (share == 0) return equal_split{0, total};
+    return equal_split{share, total - share * count};
+}
+
+/**
+ * @brief Increase of the reward-per-stake accumulator for a staker payout
+ */
+inline uint128 reward_per_stake_increment(uint64_t total_amount, uint64_t total_staked) {
+    if (total_amount == 0 || total_staked == 0) return 0;
+    return (uint128(total_amount) * REWARD_PRECISION) / total_staked;
+}
+
+/**
+ * @brief Reward accrued on a position since its snapshot of the accumulator
+ */
+inline uint64_t accrued_reward(int64_t amount, uint128 reward_per_stake, uint128 snapshot) {
+    if (amount <= 0 || reward_per_stake <= snapshot) return 0;
+    return static_cast<uint64_t>((uint128(amount) * (reward_per_stake - snapshot)) / REWARD_PRECISION);
+}
+
+// ============ RESPECT ============
+
+/**
+ * @brief Respect value in effect for the committed round
+ *
+ * A staged value applies once its round has been committed
+ * (staged_round <= round); until then the previous value is used.
+ * 0 means the account has no Respect yet.
+ */
+inline uint32_t effective_respect(uint32_t respect, uint32_t staged_respect,
+                                  uint64_t staged_round, uint64_t round) {
+    if (staged_round != 0 && staged_round <= round) return staged_respect;
+    return respect;
+}
+
+// ============ KEYS AND ENCODING ============
+
+/**
+ * @brief First 64 bits of a 32-byte hash, big-endian
+ */
+inline uint64_t hash_prefix(const uint8_t* bytes) {
+    uint64_t prefix = 0;
+    for (int i = 0; i < 8; i++) {
+        prefix = (prefix << 8) | bytes[i];
+    }
+    return prefix;
+}
+
+// Hash-derived primary keys stay below this; keys at or above it are
+// handed out by the overflow path once a hash's probe window is full
+constexpr uint64_t OVERFLOW_KEY_BASE = uint64_t(1) << 63;
+
+/**
+ * @brief Probe slot `i` for a hash prefix, wrapping below OVERFLOW_KEY_BASE
+ */
+inline uint64_t hash_slot(uint64_t prefix, uint64_t i) {
+    return (prefix + i) & (OVERFLOW_KEY_BASE - 1);
+}
+
+// Slots probed for a hash prefix before falling back to the overflow range
+constexpr uint64_t HASH_PROBE_WINDOW = 4;
+
+/**
+ * @brief What a probed slot holds, as reported by the caller's table lookup
+ */
+enum class slot_state : uint8_t { empty, other, match };
+
+/**
+ * @brief Outcome of scanning a hash's probe window
+ */
+struct window_probe {
+    bool     found = false;     // A slot holds the hash, at key
+    uint64_t key = 0;
+    bool     has_free = false;  // A slot is free, the first one at free_key
+    uint64_t free_key = 0;
+};
+
+/**
+ * @brief Scan hash_slot(prefix, 0 .. HASH_PROBE_WINDOW-1) in order
+ *
+ * Stops at the slot holding the hash. The scan does not stop at a free
+ * slot: a row may sit past a slot freed after it was inserted.
+ *
+ * @param slot_of - Callable mapping a key to its slot_state
+ */
+template<typename SlotOf>
+inline window_probe probe_window(uint64_t prefix, SlotOf slot_of) {
+    window_probe probe;
+    for (uint64_t i = 0; i < HASH_PROBE_WINDOW; ++i) {
+        uint64_t key = hash_slot(prefix, i);
+        slot_state state = slot_of(key);
+        if (state == slot_state::match) {
+            probe.found = true;
+            probe.key = key;
+            return probe;
+        }
+        if (state == slot_state::empty && !probe.has_free) {
+            probe.has_free = true;
+            probe.free_key = key;
+        }
+    }
+    return probe;
+}
+
+/**
+ * @brief Key for a row whose probe window is full
+ *
+ * Above every overflow key in use: the table's next available primary
+ * key, which is past every probe slot once any overflow row exists.
+ */
+inline uint64_t overflow_key(uint64_t available_primary_key) {
+    return available_primary_key > OVERFLOW_KEY_BASE ? available_primary_key : OVERFLOW_KEY_BASE;
+}
+
+/**
+ * @brief Composite 128-bit key: account in the high half, hash prefix in the low half
+ */
+inline uint128 combine_keys(uint64_t account, uint64_t hash_prefix_value) {
+    return (uint128(account) << 64) | uint128(hash_prefix_value);
+}
+
+/**
+ * @brief Lowercase hex encoding of a byte string
+ */
+inline std::string to_hex(const uint8_t* data, size_t size) {
+    static const char hex_chars[] = "0123456789abcdef";
+    std::string result;
+    result.reserve(size * 2);
+    for (size_t i = 0; i < size; i++) {
+        result += hex_chars[(data[i] >> 4) & 0xF];
+        result += hex_chars[data[i] & 0xF];
+    }
+    return result;
+}
+
+// ============ EVENT TYPES ============
+
+// Valid type codes and the content range (content counts toward x and may emit)
+constexpr uint8_t MIN_EVENT_TYPE = 1;
+constexpr uint8_t MAX_EVENT_TYPE = 99;
+constexpr uint8_t MIN_CONTENT_TYPE = 20;
+constexpr uint8_t MAX_CONTENT_TYPE = 39;
+
+/**
+ * @brief Which configurable voting window an event type uses (vote_window_* in globals)
+ */
+enum class window_slot : uint8_t { standard, release, mint, resolve, claim, merge };
+
+/**
+ * @brief Which configurable emission multiplier an event type uses (multiplier_* in globals)
+ */
+enum class multiplier_slot : uint8_t { none, release, mint, resolve, add_claim, edit_claim, merge };
+
+/**
+ * @brief Everything put, vote and finalize need to know about an event type
+ *
+ * Votable types get a tally row on their first vote; the others never do.
+ */
+struct event_policy {
+    bool valid = false;
+    bool content = false;
+    bool votable = false;
+    bool requires_attestation = false;
+    window_slot window = window_slot::standard;
+    multiplier_slot multiplier = multiplier_slot::none;
+
+    constexpr bool emits() const { return content && multiplier != multiplier_slot::none; }
+};
+
+struct event_registry {
+    event_policy types[256];
+};
+
+/**
+ * @brief Build the policy of every type code
+ *
+ * Codes in [MIN_EVENT_TYPE, MAX_EVENT_TYPE] are valid and votable with the
+ * standard window unless listed below. Attestation is off for every type
+ * until Respect-based governance is in place.
+ */
+constexpr event_registry make_event_registry() {
+    event_registry r{};
+    for (int code = MIN_EVENT_TYPE; code <= MAX_EVENT_TYPE; ++code) {
+        r.types[code].valid = true;
+        r.types[code].content = (code >= MIN_CONTENT_TYPE && code <= MAX_CONTENT_TYPE);
+        r.types[code].votable = true;
+    }
+
+    r.types[21].window = window_slot::release;      // CREATE_RELEASE_BUNDLE
+    r.types[21].multiplier = multiplier_slot::release;
+    r.types[22].window = window_slot::mint;         // MINT_ENTITY
+    r.types[22].multiplier = multiplier_slot::mint;
+    r.types[23].window = window_slot::resolve;      // RESOLVE_ID
+    r.types[23].multiplier = multiplier_slot::resolve;
+    r.types[30].window = window_slot::claim;        // ADD_CLAIM
+    r.types[30].multiplier = multiplier_slot::add_claim;
+    r.types[31].window = window_slot::claim;        // EDIT_CLAIM
+    r.types[31].multiplier = multiplier_slot::edit_claim;
+
+    // MERGE_ENTITY sits outside the content range: it neither counts toward x
+    // nor emits, so multiplier_merge only takes effect if that range changes
+    r.types[60].window = window_slot::merge;
+    r.types[60].multiplier = multiplier_slot::merge;
+
+    // Activity records: VOTE, LIKE, DISCUSS, FINALIZE
+    r.types[40].votable = false;
+    r.types[41].votable = false;
+    r.types[42].votable = false;
+    r.types[50].votable = false;
+    return r;
+}
+
+constexpr event_registry EVENT_REGISTRY = make_event_registry();
+
+/**
+ * @brief Policy of a type code (invalid codes return a policy with valid == false)
+ */
+constexpr const event_policy& policy_of(uint8_t type) {
+    return EVENT_REGISTRY.types[type];
+}
+
+static_assert(!policy_of(0).valid && !policy_of(MAX_EVENT_TYPE + 1).valid, "type range");
+static_assert(policy_of(21).emits() && policy_of(30).emits() && !policy_of(60).emits(), "emitting types");
+static_assert(!policy_of(40).votable && !policy_of(50).votable && policy_of(99).votable, "votable types");
+
+} // namespace polaris_core
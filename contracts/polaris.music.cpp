@@ -23,11 +23,23 @@
 #include <eosio/singleton.hpp>
 #include <eosio/system.hpp>
 #include <eosio/action.hpp>
-#include <cmath>
 #include <limits>
 
+#include "polaris.core.hpp"
+
 using namespace eosio;
 
+// Per-action cost counters, compiled in only with -DPERF_STATS (see perf_counters)
+#ifdef PERF_STATS
+#define PERF_ACTION(action_name) perf_scope perf_guard_{*this, action_name}
+#define PERF_ADD(field, n) (perf_counts.field += (n))
+#define PERF_RAM(row) PERF_ADD(ram_bytes, eosio::pack_size(row))
+#else
+#define PERF_ACTION(action_name) ((void)0)
+#define PERF_ADD(field, n) ((void)0)
+#define PERF_RAM(row) ((void)0)
+#endif
+
 /**
  * @brief Main Polaris Music Registry contract
  *
@@ -39,6 +51,194 @@ CONTRACT polaris : public contract {
 public:
     using contract::contract;
 
+    /**
+     * @brief One event to anchor (putbatch() input, same fields as put())
+     */
+    struct anchor_input {
+        uint8_t     type;
+        checksum256 hash;
+        std::string event_cid;
+        std::optional<checksum256> parent;
+        uint32_t    ts;
+        std::vector<name> tags;
+
+        EOSLIB_SERIALIZE(anchor_input, (type)(hash)(event_cid)(parent)(ts)(tags))
+    };
+
+    /**
+     * @brief Per-anchor entry of the anchorbatch notification
+     */
+    struct anchor_summary {
+        uint8_t     type;
+        checksum256 hash;
+        uint64_t    anchor_id;
+        uint64_t    submission_number;
+        uint32_t    expires_at;         // When voting closes
+        uint64_t    escrowed_amount;    // Tokens minted into escrow
+
+        EOSLIB_SERIALIZE(anchor_summary, (type)(hash)(anchor_id)(submission_number)
+                                         (expires_at)(escrowed_amount))
+    };
+
+    /**
+     * @brief One applied vote (voteevent notification entry)
+     */
+    struct vote_summary {
+        uint64_t    anchor_id;
+        checksum256 tx_hash;
+        int8_t      val;            // +1, 0 (vote withdrawn) or -1
+        uint32_t    weight;         // Respect weight recorded with the vote
+
+        EOSLIB_SERIALIZE(vote_summary, (anchor_id)(tx_hash)(val)(weight))
+    };
+
+    /**
+     * @brief Outcome and payout split of one settled anchor (finalevent entry)
+     */
+    struct settlement_summary {
+        uint64_t    anchor_id;
+        checksum256 tx_hash;
+        bool        accepted;
+        uint64_t    up_weight;
+        uint64_t    down_weight;
+        uint64_t    escrowed_amount;    // Total distributed
+        uint64_t    author_amount;      // Credited to the author
+        int8_t      rewarded_side;      // +1 YES voters, -1 NO voters, 0 none
+        uint64_t    voter_share;        // Claimable per rewarded voter (claimvote)
+        uint32_t    rewarded_voters;    // Voters entitled to voter_share
+        uint64_t    staker_amount;      // Staker share (stays in the contract if nothing is staked)
+
+        EOSLIB_SERIALIZE(settlement_summary, (anchor_id)(tx_hash)(accepted)(up_weight)(down_weight)
+                                             (escrowed_amount)(author_amount)(rewarded_side)
+                                             (voter_share)(rewarded_voters)(staker_amount))
+    };
+
+    /**
+     * @brief Anchor metadata, settlement state and tally (getanchor() result)
+     */
+    struct anchor_view {
+        uint64_t    anchor_id;
+        uint64_t    seq;
+        name        author;
+        uint8_t     type;
+        checksum256 hash;
+        std::string event_cid;
+        std::optional<checksum256> parent;
+        uint32_t    ts;
+        std::vector<name> tags;
+        uint32_t    expires_at;
+        bool        finalized;
+        uint64_t    escrowed_amount;
+        uint64_t    submission_x;
+        uint64_t    up_weight;
+        uint64_t    down_weight;
+        uint32_t    up_voter_count;
+        uint32_t    down_voter_count;
+        int8_t      rewarded_side;
+        uint64_t    voter_share;
+
+        EOSLIB_SERIALIZE(anchor_view, (anchor_id)(seq)(author)(type)(hash)(event_cid)(parent)
+                                      (ts)(tags)(expires_at)(finalized)(escrowed_amount)
+                                      (submission_x)(up_weight)(down_weight)(up_voter_count)
+                                      (down_voter_count)(rewarded_side)(voter_share))
+    };
+
+    /**
+     * @brief One unfinalized anchor in expiry order (getopen() row)
+     */
+    struct open_anchor {
+        uint64_t    anchor_id;
+        checksum256 hash;
+        name        author;
+        uint8_t     type;
+        uint32_t    expires_at;
+        uint64_t    escrowed_amount;
+
+        EOSLIB_SERIALIZE(open_anchor, (anchor_id)(hash)(author)(type)(expires_at)(escrowed_amount))
+    };
+
+    /**
+     * @brief Page of getopen() results
+     */
+    struct open_anchor_page {
+        std::vector<open_anchor> rows;
+        uint32_t    next_expires_at; // start_expires_at of the next page (0 = no more rows)
+        uint64_t    next_id;         // start_id of the next page
+
+        EOSLIB_SERIALIZE(open_anchor_page, (rows)(next_expires_at)(next_id))
+    };
+
+    /**
+     * @brief One anchor in a tag or thread listing (gettag() / getthread() row)
+     */
+    struct anchor_ref {
+        uint64_t    anchor_id;
+        uint64_t    seq;
+        checksum256 hash;
+        name        author;
+        uint8_t     type;
+        bool        finalized;
+
+        EOSLIB_SERIALIZE(anchor_ref, (anchor_id)(seq)(hash)(author)(type)(finalized))
+    };
+
+    /**
+     * @brief Page of gettag() results
+     */
+    struct anchor_ref_page {
+        std::vector<anchor_ref> rows;
+        uint64_t    next_seq;       // before_seq of the next page (0 = no more rows)
+
+        EOSLIB_SERIALIZE(anchor_ref_page, (rows)(next_seq))
+    };
+
+    /**
+     * @brief Page of a discussion thread (getthread() result)
+     */
+    struct thread_page {
+        uint64_t    parent_id;      // Anchor ID of the parent
+        uint32_t    child_count;    // Direct replies indexed under the parent
+        uint32_t    last_child_at;  // When the latest reply was anchored (0 = none)
+        std::vector<anchor_ref> rows;
+        uint64_t    next_seq;       // start_seq of the next page (0 = no more rows)
+
+        EOSLIB_SERIALIZE(thread_page, (parent_id)(child_count)(last_child_at)(rows)(next_seq))
+    };
+
+    /**
+     * @brief One stake position with its claimable reward (getportfolio() row)
+     */
+    struct stake_position {
+        checksum256 node_id;
+        asset       amount;         // Currently staked
+        asset       pending;        // Claimable through claimreward()
+
+        EOSLIB_SERIALIZE(stake_position, (node_id)(amount)(pending))
+    };
+
+    /**
+     * @brief Page of getportfolio() results
+     */
+    struct portfolio_page {
+        asset       balance;        // Credited, awaiting withdraw()
+        std::vector<stake_position> positions;
+        uint64_t    next_id;        // start_id of the next page (0 = no more rows)
+
+        EOSLIB_SERIALIZE(portfolio_page, (balance)(positions)(next_id))
+    };
+
+    /**
+     * @brief Stake and like aggregates of a node (getnode() result)
+     */
+    struct node_view {
+        checksum256 node_id;
+        asset       total_staked;
+        uint32_t    staker_count;
+        uint32_t    like_count;
+
+        EOSLIB_SERIALIZE(node_view, (node_id)(total_staked)(staker_count)(like_count))
+    };
+
     // ============ CORE ANCHORING ACTIONS ============
 
     /**
@@ -68,153 +268,118 @@ public:
     ACTION put(name author, uint8_t type, checksum256 hash, std::string event_cid,
                std::optional<checksum256> parent, uint32_t ts,
                std::vector<name> tags) {
+        PERF_ACTION("put"_n);
         require_auth(author);
 
         // Check if contract is paused
         auto g = get_globals();
         check(!g.paused, "Contract is paused");
+        require_migrated(g, MIGRATE_ANCHORS);
 
-        // Validate inputs
-        check(type >= MIN_EVENT_TYPE && type <= MAX_EVENT_TYPE, "Invalid event type");
-        check(ts >= MIN_VALID_TIMESTAMP, "Timestamp too far in past (minimum 2023-01-01)");
-        check(!event_cid.empty(), "Event CID is required");
-        check(event_cid.length() < 200, "Event CID too long (max 200 chars)");
-        check(tags.size() <= 10, "Too many tags (max 10)");
-
-        // Validate each tag format and length
-        for (const auto& tag : tags) {
-            check(tag.length() >= 3, "Tag too short (minimum 3 characters): " + tag.to_string());
-            check(tag.length() <= 12, "Tag too long (maximum 12 characters): " + tag.to_string());
-            // Note: Antelope name type already validates format (a-z, 1-5, dots only)
-        }
-
-        // Prevent duplicate hashes
         anchors_table anchors(get_self(), get_self().value);
-        auto hash_idx = anchors.get_index<"byhash"_n>();
-        check(hash_idx.find(hash) == hash_idx.end(), "Event hash already exists");
-
-        // Validate parent hash exists if provided
-        if(parent.has_value()) {
-            auto parent_itr = hash_idx.find(parent.value());
-            check(parent_itr != hash_idx.end(), "Parent event not found");
-        }
-
-        // Get current blockchain time for expiry calculation
+        anchorstate_table states(get_self(), get_self().value);
         uint32_t current_time = current_time_point().sec_since_epoch();
-        check(ts <= current_time + 300, "Timestamp too far in future (max 5 min)");
 
-        // Calculate voting window based on event type
-        uint32_t vote_window = get_vote_window(type);
-        uint32_t expires_at = current_time + vote_window;
-
-        // Store the anchor on-chain
-        uint64_t anchor_id = anchors.available_primary_key();
-
-        // Capture submission-time x BEFORE incrementing (for escrow-based emission)
-        uint64_t submission_x = g.x;
-
-        // Calculate emission at submission time using submission_x
-        uint64_t multiplier = get_multiplier(type);
-        uint64_t mint = 0;
+        anchor_receipt receipt = store_anchor(g, anchors, states, author,
+                                              anchor_input{type, hash, event_cid, parent, ts, tags},
+                                              current_time);
+        check_supply_cap(g);
 
-        if (type >= MIN_CONTENT_TYPE && type <= MAX_CONTENT_TYPE && multiplier > 0) {
-            double x = static_cast<double>(submission_x);
+        globals_singleton globals(get_self(), get_self().value);
+        PERF_ADD(rows_written, 1);
+        globals.set(g, get_self());
 
-            if (x >= 1.0) {
-                // Calculate emission using logarithmic curve: g(x) = m * ln(x) / x
-                double g_raw = multiplier * std::log(x) / x;
-                double total_with_carry = g_raw + g.carry;
+        // Emit event for off-chain indexers
+        notify("anchorevent"_n, author, type, hash, receipt.anchor_id, receipt.submission_x,
+               event_cid, parent, ts, tags, receipt.expires_at, receipt.mint);
+    }
 
-                // Prevent overflow when casting to uint64_t
-                constexpr double MAX_MINT = 10000000000000000.0; // 1 trillion * 10000
-                if(total_with_carry > MAX_MINT) {
-                    total_with_carry = MAX_MINT;
-                }
+    /**
+     * @brief Anchor several off-chain events from the same author in one action
+     *
+     * Bulk counterpart of put() for ingestion pipelines and backfills. Each
+     * anchor is validated and stored exactly as put() would, but globals are
+     * read and written once, and one anchorbatch notification replaces per-anchor
+     * anchorevent notifications. Any invalid anchor aborts the whole batch.
+     *
+     * @param author - The blockchain account submitting the events
+     * @param anchors - Events to anchor (same fields as put(), max 50)
+     */
+    ACTION putbatch(name author, std::vector<anchor_input> anchors) {
+        PERF_ACTION("putbatch"_n);
+        require_auth(author);
 
-                mint = static_cast<uint64_t>(total_with_carry);
-                g.carry = total_with_carry - mint;
-            }
-        }
+        auto g = get_globals();
+        check(!g.paused, "Contract is paused");
+        require_migrated(g, MIGRATE_ANCHORS);
 
-        // Mint tokens to contract (escrow) if emission > 0
-        if (mint > 0) {
-            issue_tokens(get_self(), mint, "Escrow for anchor " + std::to_string(anchor_id));
-        }
+        check(!anchors.empty(), "Empty anchor batch");
+        check(anchors.size() <= MAX_PUT_BATCH, "Too many anchors in batch (max 50)");
 
-        anchors.emplace(author, [&](auto& a) {
-            a.id = anchor_id;
-            a.author = author;
-            a.type = type;
-            a.hash = hash;
-            a.event_cid = event_cid;
-            a.parent = parent;
-            a.ts = ts;
-            a.tags = tags;
-            a.expires_at = expires_at;
-            a.finalized = false;
-            a.escrowed_amount = mint;
-            a.submission_x = submission_x;
-        });
+        anchors_table anchor_rows(get_self(), get_self().value);
+        anchorstate_table states(get_self(), get_self().value);
+        uint32_t current_time = current_time_point().sec_since_epoch();
 
-        // Initialize zeroed tally row for this anchor
-        votetally_table tallies(get_self(), get_self().value);
-        tallies.emplace(author, [&](auto& t) {
-            t.anchor_id = anchor_id;
-            t.tx_hash = hash;
-            t.up_weight = 0;
-            t.down_weight = 0;
-            t.up_voter_count = 0;
-            t.down_voter_count = 0;
-            t.updated_at = current_time_point();
-        });
+        std::vector<anchor_summary> summaries;
+        summaries.reserve(anchors.size());
 
-        // NOW increment global submission counter AFTER capturing submission_x
-        // Only increment for content submissions, not votes/likes/discussions
-        if (type >= MIN_CONTENT_TYPE && type <= MAX_CONTENT_TYPE) {
-            g.x += 1; // Global submission number
+        for (const auto& input : anchors) {
+            anchor_receipt receipt = store_anchor(g, anchor_rows, states, author, input, current_time);
+            summaries.push_back(anchor_summary{input.type, input.hash, receipt.anchor_id, receipt.submission_x,
+                                               receipt.expires_at, receipt.mint});
         }
+        check_supply_cap(g);
 
         globals_singleton globals(get_self(), get_self().value);
+        PERF_ADD(rows_written, 1);
         globals.set(g, get_self());
 
-        // Emit event for off-chain indexers
-        emit_anchor_event(author, type, hash, anchor_id, submission_x);
+        // Emit one compact notification for the whole batch
+        notify("anchorbatch"_n, author, summaries);
     }
 
     /**
      * @brief Attest to the validity of a submission
      *
      * High-value submissions (like release bundles) require attestation from
-     * trusted community members before they can be finalized.
+     * trusted community members before they can be accepted at finalization.
+     * Each attestor counts once per anchor; the count is kept on the
+     * anchor's settlement state so finalization reads a single field.
      *
      * @param attestor - Account providing attestation (must be authorized)
      * @param tx_hash - Hash of the event being attested
      * @param confirmed_type - Event type being confirmed (must match)
      */
     ACTION attest(name attestor, checksum256 tx_hash, uint8_t confirmed_type) {
+        PERF_ACTION("attest"_n);
         require_auth(attestor);
 
         // Verify attestor is authorized
-        check(is_authorized_attestor(attestor), "Not an authorized attestor");
+        auto g = get_globals();
+        require_migrated(g, MIGRATE_ATTESTATIONS);
+        check(is_authorized_attestor(g, attestor), "Not an authorized attestor");
 
         // Verify the anchor exists
-        anchors_table anchors(get_self(), get_self().value);
-        auto hash_idx = anchors.get_index<"byhash"_n>();
-        auto anchor_itr = hash_idx.find(tx_hash);
-        check(anchor_itr != hash_idx.end(), "Anchor not found");
+        anchorstate_table states(get_self(), get_self().value);
+        auto anchor_itr = find_anchor_state(states, tx_hash);
+        check(anchor_itr != states.end(), "Anchor not found");
         check(anchor_itr->type == confirmed_type, "Event type mismatch");
         check(!anchor_itr->finalized, "Already finalized");
 
-        // Store attestation
-        attestations_table attestations(get_self(), get_self().value);
-        uint64_t att_id = attestations.available_primary_key();
+        // Store attestation (one per attestor and anchor)
+        attestations_table attestations(get_self(), anchor_itr->anchor_id);
+        check(attestations.find(attestor.value) == attestations.end(), "Already attested");
 
+        PERF_ADD(rows_written, 1);
         attestations.emplace(attestor, [&](auto& a) {
-            a.id = att_id;
-            a.tx_hash = tx_hash;
             a.attestor = attestor;
-            a.type = confirmed_type;
             a.ts = current_time_point();
+            PERF_RAM(a);
+        });
+
+        PERF_ADD(rows_written, 1);
+        states.modify(anchor_itr, same_payer, [&](auto& st) {
+            st.attestation_count += 1;
         });
     }
 
@@ -223,58 +388,93 @@ public:
      *
      * Likes track the path taken through the graph to reach the liked entity.
      * This data helps understand how users discover music and navigate relationships.
+     * Only a digest and the length of the path are kept on-chain; the full
+     * path is carried by this action's data, which indexers decode.
      *
      * @param account - Account doing the liking (must be authorized)
      * @param node_id - SHA256 identifier of entity being liked
      * @param node_path - The path through the graph to reach this node
      */
     ACTION like(name account, checksum256 node_id, std::vector<checksum256> node_path) {
+        PERF_ACTION("like"_n);
         require_auth(account);
+        require_migrated(get_globals(), MIGRATE_LIKES);
 
         check(node_path.size() > 0, "Path must contain at least one node");
         check(node_path.size() <= 20, "Path too long (max 20 nodes)");
         check(node_path.back() == node_id, "Path must end at liked node");
 
+        // Digest of the packed path (full path stays in the action data)
+        auto packed_path = pack(node_path);
+        checksum256 path_hash = sha256(packed_path.data(), packed_path.size());
+
         // Store like record
         likes_table likes(get_self(), account.value);
-        auto likes_by_node = likes.get_index<"bynode"_n>();
-        auto itr = likes_by_node.find(node_id);
+        auto like_probe = probe_hash_key(likes, node_id, &like_record::node_id);
+        auto itr = like_probe.first;
+        uint64_t like_key = like_probe.second;
 
-        bool is_new_like = (itr == likes_by_node.end());
+        bool is_new_like = (itr == likes.end());
 
+        // A schema 1 like is already counted in the aggregate: replace it
         if (is_new_like) {
+            legacy_likes_table legacy_likes(get_self(), account.value);
+            auto legacy_by_node = legacy_likes.get_index<"bynode"_n>();
+            PERF_ADD(rows_read, 1);
+            auto legacy_itr = legacy_by_node.find(node_id);
+            if (legacy_itr != legacy_by_node.end()) {
+                PERF_ADD(rows_written, 1);
+                legacy_by_node.erase(legacy_itr);
+                is_new_like = false;
+            }
+        }
+
+        if (itr == likes.end()) {
+            PERF_ADD(rows_written, 1);
             likes.emplace(account, [&](auto& l) {
-                l.id = likes.available_primary_key();
+                l.id = like_key;
                 l.node_id = node_id;
-                l.path = node_path;
+                l.path_hash = path_hash;
+                l.path_length = static_cast<uint8_t>(node_path.size());
                 l.liked_at = current_time_point();
+                PERF_RAM(l);
             });
         } else {
-            auto pk_itr = likes.iterator_to(*itr);
-            likes.modify(pk_itr, account, [&](auto& l) {
-                l.path = node_path;
+            PERF_ADD(rows_written, 1);
+            likes.modify(itr, account, [&](auto& l) {
+                l.path_hash = path_hash;
+                l.path_length = static_cast<uint8_t>(node_path.size());
                 l.liked_at = current_time_point();
             });
         }
 
         // Update aggregate like count for the node
         likeagg_table aggregates(get_self(), get_self().value);
-        auto agg_by_node = aggregates.get_index<"bynode"_n>();
-        auto agg_itr = agg_by_node.find(node_id);
+        auto agg_probe = probe_hash_key(aggregates, node_id, &like_aggregate::node_id);
+        auto agg_itr = agg_probe.first;
+        uint64_t agg_key = agg_probe.second;
 
-        if (agg_itr == agg_by_node.end()) {
+        uint32_t like_count = 1;
+        if (agg_itr == aggregates.end()) {
+            PERF_ADD(rows_written, 1);
             aggregates.emplace(account, [&](auto& a) {
-                a.id = aggregates.available_primary_key();
+                a.id = agg_key;
                 a.node_id = node_id;
                 a.like_count = 1;
+                PERF_RAM(a);
             });
-        } else if (is_new_like) {
-            auto agg_pk_itr = aggregates.iterator_to(*agg_itr);
-            aggregates.modify(agg_pk_itr, account, [&](auto& a) {
-                a.like_count += 1;
-            });
+        } else {
+            if (is_new_like) {
+                PERF_ADD(rows_written, 1);
+                aggregates.modify(agg_itr, account, [&](auto& a) {
+                    a.like_count += 1;
+                });
+            }
+            like_count = agg_itr->like_count;
         }
 
+        notify("likeevent"_n, account, node_id, true, path_hash,
+               static_cast<uint8_t>(node_path.size()), like_count);
     }
 
     /**
@@ -284,36 +484,49 @@ public:
      * @param node_id - Node being unliked
      */
     ACTION unlike(name account, checksum256 node_id) {
+        PERF_ACTION("unlike"_n);
         require_auth(account);
+        require_migrated(get_globals(), MIGRATE_LIKES);
 
-        // Remove like record
+        // Remove like record (or the schema 1 one, which migrate() cannot reach)
         likes_table likes(get_self(), account.value);
-        auto likes_by_node = likes.get_index<"bynode"_n>();
-        auto itr = likes_by_node.find(node_id);
-        check(itr != likes_by_node.end(), "Like not found");
-        likes.erase(likes.iterator_to(*itr));
+        auto itr = find_by_hash_key(likes, node_id, &like_record::node_id);
+        if (itr != likes.end()) {
+            release_hash_key(likes, itr->id, node_id);
+            PERF_ADD(rows_written, 1);
+            likes.erase(itr);
+        } else {
+            legacy_likes_table legacy_likes(get_self(), account.value);
+            auto legacy_by_node = legacy_likes.get_index<"bynode"_n>();
+            PERF_ADD(rows_read, 1);
+            auto legacy_itr = legacy_by_node.find(node_id);
+            check(legacy_itr != legacy_by_node.end(), "Like not found");
+            PERF_ADD(rows_written, 1);
+            legacy_by_node.erase(legacy_itr);
+        }
 
         // Update aggregate (gracefully handle missing aggregate)
         likeagg_table aggregates(get_self(), get_self().value);
-        auto agg_by_node = aggregates.get_index<"bynode"_n>();
-        auto agg_itr = agg_by_node.find(node_id);
-
-        // If aggregate exists, decrement and remove if zero
-        if (agg_itr != agg_by_node.end()) {
-            auto agg_pk_itr = aggregates.iterator_to(*agg_itr);
-            aggregates.modify(agg_pk_itr, account, [&](auto& a) {
-                if (a.like_count > 0) {
+        auto agg_itr = find_by_hash_key(aggregates, node_id, &like_aggregate::node_id);
+
+        // If aggregate exists, decrement or remove when it reaches zero
+        uint32_t like_count = 0;
+        if (agg_itr != aggregates.end()) {
+            if (agg_itr->like_count <= 1) {
+                release_hash_key(aggregates, agg_itr->id, node_id);
+                PERF_ADD(rows_written, 1);
+                aggregates.erase(agg_itr);
+            } else {
+                PERF_ADD(rows_written, 1);
+                aggregates.modify(agg_itr, account, [&](auto& a) {
                     a.like_count -= 1;
-                }
-            });
-
-            // Remove aggregate if count reaches zero
-            if (agg_itr->like_count == 0) {
-                aggregates.erase(aggregates.iterator_to(*agg_itr));
+                });
+                like_count = agg_itr->like_count;
             }
         }
 
         // If aggregate doesn't exist, that's okay - like record was still removed
+        notify("likeevent"_n, account, node_id, false, checksum256(), uint8_t(0), like_count);
     }
 
     // ============ FRACTALLY INTEGRATION ============
@@ -329,18 +542,22 @@ public:
      */
     ACTION updrespect(std::vector<std::pair<name, uint32_t>> respect_data,
                          uint64_t election_round) {
+        PERF_ACTION("updrespect"_n);
         // Only Fractally contract or designated oracle can update
-        require_auth(get_fractally_oracle());
+        auto g = get_globals();
+        require_auth(g.fractally_oracle);
+        require_migrated(g, MIGRATE_RESPECT);
 
         check(respect_data.size() > 0, "Empty respect data");
         check(respect_data.size() <= 1000, "Too many updates in one transaction");
 
         // Validate election round is incrementing (prevents replaying old data)
         globals_singleton globals(get_self(), get_self().value);
-        auto g = get_globals();
         check(election_round > g.round, "Election round must increment (prevents stale data)");
+        check(g.staging_round == 0, "Respect epoch staging in progress (use respchunk/respcommit)");
 
         respect_table respect(get_self(), get_self().value);
+        std::vector<std::pair<name, uint32_t>> changes;
 
         for (const auto& item : respect_data) {
             name account = item.first;
@@ -351,27 +568,248 @@ public:
             auto itr = respect.find(account.value);
 
             if (itr == respect.end()) {
+                changes.push_back(item);
+
                 // New member receiving Respect
+                PERF_ADD(rows_written, 1);
                 respect.emplace(get_self(), [account, respect_value, election_round](auto& r) {
                     r.account = account;
                     r.respect = respect_value;
                     r.round = election_round;
                     r.updated_at = current_time_point();
+                    PERF_RAM(r);
                 });
-            } else {
-                // Update existing Respect
-                respect.modify(itr, get_self(), [respect_value, election_round](auto& r) {
+            } else if (effective_respect(*itr, g) != respect_value || itr->staged_round != 0) {
+                if (effective_respect(*itr, g) != respect_value) changes.push_back(item);
+
+                // Update existing Respect (unchanged values are skipped)
+                PERF_ADD(rows_written, 1);
+                respect.modify(itr, get_self(), [&](auto& r) {
                     r.respect = respect_value;
                     r.round = election_round;
+                    r.staged_round = 0;
                     r.updated_at = current_time_point();
                 });
             }
         }
 
-
         // Update global round after successful processing
         g.round = election_round;
+        PERF_ADD(rows_written, 1);
+        globals.set(g, get_self());
+
+        notify("respevent"_n, election_round, false, changes);
+    }
+
+    /**
+     * @brief Open a staged Respect epoch
+     *
+     * Starts a multi-transaction load of an election's results: any number
+     * of respchunk() calls followed by respcommit(). Values pushed in
+     * between are staged on the respect rows and ignored by vote weighting
+     * until the round is committed, so votes keep using the previous
+     * round's snapshot while the load is in progress.
+     *
+     * @param election_round - Fractally round being loaded (must exceed current round)
+     */
+    ACTION respbegin(uint64_t election_round) {
+        PERF_ACTION("respbegin"_n);
+        auto g = get_globals();
+        require_auth(g.fractally_oracle);
+
+        check(election_round > g.round, "Election round must increment (prevents stale data)");
+        check(g.staging_round == 0, "Respect epoch staging already in progress");
+
+        globals_singleton globals(get_self(), get_self().value);
+        g.staging_round = election_round;
+        PERF_ADD(rows_written, 1);
+        globals.set(g, get_self());
+    }
+
+    /**
+     * @brief Stage one chunk of a Respect epoch
+     *
+     * Only values that differ from the account's current Respect are
+     * written. Pushing an account again within the same epoch replaces its
+     * staged value; pushing its current value withdraws the staged change.
+     *
+     * @param election_round - Round opened by respbegin()
+     * @param respect_data - Array of account:respect pairs (max 1000)
+     */
+    ACTION respchunk(uint64_t election_round, std::vector<std::pair<name, uint32_t>> respect_data) {
+        PERF_ACTION("respchunk"_n);
+        auto g = get_globals();
+        require_auth(g.fractally_oracle);
+        require_migrated(g, MIGRATE_RESPECT);
+
+        check(g.staging_round != 0 && election_round == g.staging_round,
+              "Election round is not being staged (call respbegin first)");
+        check(!abort_singleton(get_self(), get_self().value).exists(),
+              "Respect epoch is being aborted (call respabort until it completes)");
+        check(respect_data.size() > 0, "Empty respect data");
+        check(respect_data.size() <= 1000, "Too many updates in one transaction");
+
+        respect_table respect(get_self(), get_self().value);
+        std::vector<std::pair<name, uint32_t>> changes;
+
+        for (const auto& item : respect_data) {
+            name account = item.first;
+            uint32_t respect_value = item.second;
+
+            check(respect_value > 0, "Respect must be positive");
+            check(respect_value <= 1000, "Respect value too high (max 1000)");
+            auto itr = respect.find(account.value);
+
+            if (itr == respect.end()) {
+                changes.push_back(item);
+
+                // New member: no live Respect until the round is committed
+                PERF_ADD(rows_written, 1);
+                respect.emplace(get_self(), [&](auto& r) {
+                    r.account = account;
+                    r.respect = 0;
+                    r.round = 0;
+                    r.staged_respect = respect_value;
+                    r.staged_round = election_round;
+                    r.updated_at = current_time_point();
+                    PERF_RAM(r);
+                });
+                continue;
+            }
+
+            // Fold a previously committed staged value into the live fields
+            bool committed = itr->staged_round != 0 && itr->staged_round <= g.round;
+            uint32_t live_respect = committed ? itr->staged_respect : itr->respect;
+            bool pending = itr->staged_round == election_round;
+
+            if (respect_value == live_respect) {
+                // Unchanged: only touch the row to fold or withdraw staging
+                if (!committed && !pending) continue;
+            } else if (pending && itr->staged_respect == respect_value) {
+                continue; // Same value already staged
+            }
+
+            // Value the account will hold once the round is committed
+            if (respect_value != live_respect || pending) {
+                changes.push_back({account, respect_value});
+            }
+
+            PERF_ADD(rows_written, 1);
+            respect.modify(itr, get_self(), [&](auto& r) {
+                if (committed) {
+                    r.respect = r.staged_respect;
+                    r.round = r.staged_round;
+                }
+                if (respect_value == live_respect) {
+                    r.staged_respect = 0;
+                    r.staged_round = 0;
+                } else {
+                    r.staged_respect = respect_value;
+                    r.staged_round = election_round;
+                }
+                r.updated_at = current_time_point();
+            });
+        }
+
+        notify("respevent"_n, election_round, true, changes);
+    }
+
+    /**
+     * @brief Commit a staged Respect epoch
+     *
+     * Switches the active round to the staged one in a single globals
+     * write. Staged values take effect immediately for vote weighting and
+     * attestor checks; rows are folded lazily on their next update.
+     *
+     * @param election_round - Round opened by respbegin()
+     */
+    ACTION respcommit(uint64_t election_round) {
+        PERF_ACTION("respcommit"_n);
+        auto g = get_globals();
+        require_auth(g.fractally_oracle);
+
+        check(g.staging_round != 0 && election_round == g.staging_round,
+              "Election round is not being staged (call respbegin first)");
+        check(!abort_singleton(get_self(), get_self().value).exists(),
+              "Respect epoch is being aborted (call respabort until it completes)");
+
+        globals_singleton globals(get_self(), get_self().value);
+        g.round = election_round;
+        g.staging_round = 0;
+        PERF_ADD(rows_written, 1);
+        globals.set(g, get_self());
+    }
+
+    /**
+     * @brief Abort a staged Respect epoch that cannot be completed
+     *
+     * Recovery for a load the oracle will never commit (lost results or
+     * keys). Clearing staging_round alone is not enough: the staged values
+     * would take effect once any later round is committed. This walks the
+     * respect table in bounded slices and discards every value staged for
+     * the round, erasing rows of members the epoch added. respchunk() and
+     * respcommit() are refused while the walk runs; staging closes, and
+     * respbegin() and updrespect() are accepted again, once it completes.
+     * The completing call emits an abortevent notification so indexers
+     * drop the round's staged respevent changes.
+     *
+     * @param election_round - Round opened by respbegin()
+     * @param max_rows - Maximum respect rows visited (1-500)
+     * @return true once the epoch is aborted
+     */
+    [[eosio::action]]
+    bool respabort(uint64_t election_round, uint32_t max_rows) {
+        PERF_ACTION("respabort"_n);
+        require_auth(get_self());
+        auto g = get_globals();
+        require_migrated(g, MIGRATE_RESPECT);
+
+        check(max_rows > 0 && max_rows <= MAX_RESPABORT_ROWS, "max_rows must be 1-500");
+        check(g.staging_round != 0 && election_round == g.staging_round,
+              "Election round is not being staged");
+
+        abort_singleton aborting(get_self(), get_self().value);
+        auto progress = aborting.get_or_default();
+
+        respect_table respect(get_self(), get_self().value);
+        auto itr = respect.lower_bound(progress.cursor);
+        for (uint32_t visited = 0; itr != respect.end() && visited < max_rows; ++visited) {
+            PERF_ADD(rows_read, 1);
+            if (itr->staged_round != election_round) {
+                ++itr;
+                continue;
+            }
+            PERF_ADD(rows_written, 1);
+            if (itr->respect == 0 && itr->round == 0) {
+                // Member added by this epoch: no live Respect to keep
+                itr = respect.erase(itr);
+            } else {
+                respect.modify(itr, same_payer, [&](auto& r) {
+                    r.staged_respect = 0;
+                    r.staged_round = 0;
+                });
+                ++itr;
+            }
+        }
+
+        if (itr != respect.end()) {
+            progress.cursor = itr->account.value;
+            PERF_ADD(rows_written, 1);
+            aborting.set(progress, get_self());
+            return false;
+        }
+
+        if (aborting.exists()) {
+            PERF_ADD(rows_written, 1);
+            aborting.remove();
+        }
+        globals_singleton globals(get_self(), get_self().value);
+        g.staging_round = 0;
+        PERF_ADD(rows_written, 1);
         globals.set(g, get_self());
+
+        notify("abortevent"_n, election_round);
+        return true;
     }
 
     /**
@@ -572,6 +1010,26 @@ public:
         globals.set(g, get_self());
     }
 
+    /**
+     * @brief Set the retention period for settled anchors
+     *
+     * prune() only erases anchors whose voting window closed at least this
+     * long ago. Voters have this long to claimvote() before their share is
+     * forfeited to stakers.
+     *
+     * @param retention_secs - Retention after window close (minimum 1 day)
+     */
+    ACTION setprune(uint32_t retention_secs) {
+        require_auth(get_self());
+
+        check(retention_secs >= 86400, "Retention must be at least 1 day");
+
+        globals_singleton globals(get_self(), get_self().value);
+        auto g = get_globals();
+        g.prune_retention = retention_secs;
+        globals.set(g, get_self());
+    }
+
     /**
      * @brief Emergency pause all critical operations
      *
@@ -618,84 +1076,79 @@ public:
      * @param val - Vote value: +1 (approve), -1 (reject), 0 (unvote/neutral)
      */
     ACTION vote(name voter, checksum256 tx_hash, int8_t val) {
+        PERF_ACTION("vote"_n);
         require_auth(voter);
-        check(val >= -1 && val <= 1, "Invalid vote value (must be -1, 0, or 1)");
 
         // Check if contract is paused
         auto g = get_globals();
         check(!g.paused, "Contract is paused");
+        require_migrated(g, MIGRATE_VOTES);
 
-        // Verify the anchor exists and voting window is still open
-        anchors_table anchors(get_self(), get_self().value);
-        auto hash_idx = anchors.get_index<"byhash"_n>();
-        auto anchor_itr = hash_idx.find(tx_hash);
-        check(anchor_itr != hash_idx.end(), "Anchor not found");
-        check(!anchor_itr->finalized, "Voting already finalized");
-        check(current_time_point().sec_since_epoch() < anchor_itr->expires_at,
-              "Voting window has closed");
-
-        // Get voter's Respect for weight calculation
-        respect_table respect(get_self(), get_self().value);
-        auto respect_itr = respect.find(voter.value);
-        uint32_t voter_respect = 1; // Default weight if no Respect
+        anchorstate_table states(get_self(), get_self().value);
+        votetally_table tallies(get_self(), get_self().value);
 
-        if(respect_itr != respect.end()) {
-            voter_respect = respect_itr->respect;
-            if(voter_respect > g.max_vote_weight) {
-                voter_respect = g.max_vote_weight;
-            }
-        }
+        uint32_t weight = get_vote_weight(g, voter);
+        uint64_t anchor_id = 0;
+        uint8_t status = apply_vote(states, tallies, voter, weight, tx_hash, val,
+                                    current_time_point().sec_since_epoch(), anchor_id);
+        check(status != VOTE_INVALID_VALUE, "Invalid vote value (must be -1, 0, or 1)");
+        check(status != VOTE_ANCHOR_NOT_FOUND, "Anchor not found");
+        check(status != VOTE_FINALIZED, "Voting already finalized");
+        check(status != VOTE_WINDOW_CLOSED, "Voting window has closed");
+        check(status != VOTE_NOT_VOTABLE, "Event type is not open to voting");
+
+        notify("voteevent"_n, voter, std::vector<vote_summary>{{anchor_id, tx_hash, val, weight}});
+    }
 
-        // Resolve tally row for this anchor
-        votetally_table tallies(get_self(), get_self().value);
-        auto tally_itr = tallies.find(anchor_itr->id);
-        check(tally_itr != tallies.end(), "Vote tally not found for anchor");
+    /**
+     * @brief Cast several votes in one action
+     *
+     * Curator counterpart of vote(): globals and the voter's Respect weight
+     * are resolved once and every vote is applied in a single pass with
+     * the same rules as vote(). An item that cannot be applied (bad value,
+     * unknown anchor, closed or finalized window) is skipped without
+     * touching state, so it does not block the rest of the batch.
+     *
+     * @param voter - Account casting the votes
+     * @param votes - (tx_hash, val) pairs, val in {-1, 0, 1} (max 100)
+     * @return Per-item status aligned with votes (0 = applied, see VOTE_* codes)
+     */
+    [[eosio::action]]
+    std::vector<uint8_t> votebatch(name voter, std::vector<std::pair<checksum256, int8_t>> votes) {
+        PERF_ACTION("votebatch"_n);
+        require_auth(voter);
 
-        // Find existing vote for this voter+hash
-        votes_table votes(get_self(), get_self().value);
-        auto vote_idx = votes.get_index<"byvoterhash"_n>();
-        uint128_t composite_key = combine_keys(voter.value, tx_hash);
-        auto vote_itr = vote_idx.find(composite_key);
+        auto g = get_globals();
+        check(!g.paused, "Contract is paused");
+        require_migrated(g, MIGRATE_VOTES);
 
-        bool has_old_vote = (vote_itr != vote_idx.end());
+        check(!votes.empty(), "Empty vote batch");
+        check(votes.size() <= MAX_VOTE_BATCH, "Too many votes in batch (max 100)");
 
-        // Remove old vote contribution from tally
-        if(has_old_vote) {
-            tally_remove_contribution(tallies, tally_itr, vote_itr->val, vote_itr->weight);
-        }
-
-        if(val == 0) {
-            // Clear vote: erase row, tally already decremented above
-            if(has_old_vote) {
-                vote_idx.erase(vote_itr);
-            }
-        } else {
-            // Add or update vote row
-            if(!has_old_vote) {
-                votes.emplace(voter, [&](auto& v) {
-                    v.id = votes.available_primary_key();
-                    v.tx_hash = tx_hash;
-                    v.voter = voter;
-                    v.val = val;
-                    v.weight = voter_respect;
-                    v.ts = current_time_point();
-                });
-            } else {
-                vote_idx.modify(vote_itr, voter, [&](auto& v) {
-                    v.val = val;
-                    v.weight = voter_respect;
-                    v.ts = current_time_point();
-                });
+        anchorstate_table states(get_self(), get_self().value);
+        votetally_table tallies(get_self(), get_self().value);
+        uint32_t weight = get_vote_weight(g, voter);
+        uint32_t now = current_time_point().sec_since_epoch();
+
+        std::vector<uint8_t> statuses;
+        statuses.reserve(votes.size());
+        std::vector<vote_summary> applied;
+
+        for (const auto& item : votes) {
+            uint64_t anchor_id = 0;
+            uint8_t status = apply_vote(states, tallies, voter, weight, item.first, item.second, now, anchor_id);
+            if (status == VOTE_APPLIED) {
+                applied.push_back(vote_summary{anchor_id, item.first, item.second, weight});
             }
+            statuses.push_back(status);
+        }
 
-            // Add new vote contribution to tally
-            tally_add_contribution(tallies, tally_itr, val, voter_respect);
+        // One notification for every vote that was applied
+        if (!applied.empty()) {
+            notify("voteevent"_n, voter, applied);
         }
 
-        // Update tally timestamp
-        tallies.modify(tally_itr, same_payer, [&](auto& t) {
-            t.updated_at = current_time_point();
-        });
+        return statuses;
     }
 
     /**
@@ -707,51 +1160,263 @@ public:
      * @param tx_hash - Hash of the event to finalize
      */
     ACTION finalize(checksum256 tx_hash) {
+        PERF_ACTION("finalize"_n);
         // Anyone can call finalize after voting window closes
 
         // Check if contract is paused
         auto g = get_globals();
         check(!g.paused, "Contract is paused");
+        require_migrated(g, MIGRATE_VOTES);
 
-        anchors_table anchors(get_self(), get_self().value);
-        auto hash_idx = anchors.get_index<"byhash"_n>();
-        auto anchor_itr = hash_idx.find(tx_hash);
-        check(anchor_itr != hash_idx.end(), "Anchor not found");
+        anchorstate_table states(get_self(), get_self().value);
+        auto anchor_itr = find_anchor_state(states, tx_hash);
+        check(anchor_itr != states.end(), "Anchor not found");
         check(!anchor_itr->finalized, "Already finalized");
         check(current_time_point().sec_since_epoch() >= anchor_itr->expires_at,
               "Voting window still open");
 
-        // Read aggregate tallies directly from on-chain tally table
         votetally_table tallies(get_self(), get_self().value);
-        auto tally_itr = tallies.find(anchor_itr->id);
-        check(tally_itr != tallies.end(), "Vote tally not found for anchor");
+        settlement_summary settled = settle_anchor(g, states, tallies, anchor_itr);
 
-        uint64_t up_votes = tally_itr->up_weight;
-        uint64_t down_votes = tally_itr->down_weight;
-        uint64_t total_votes = up_votes + down_votes;
+        globals_singleton globals(get_self(), get_self().value);
+        PERF_ADD(rows_written, 1);
+        globals.set(g, get_self());
 
-        // Retrieve escrowed amount (tokens were minted at submission time)
-        uint64_t escrowed_amount = anchor_itr->escrowed_amount;
+        notify("finalevent"_n, std::vector<settlement_summary>{settled});
+    }
 
-        // Determine payout distribution based on approval threshold
-        // Use integer basis points to avoid floating point comparison issues
-        // Default: 9000 basis points = 90.00% approval required (configurable via setparams)
-        bool accepted = (total_votes > 0) && (up_votes * 10000 >= total_votes * g.approval_threshold_bp);
+    /**
+     * @brief Finalize the next expired anchors in one transaction
+     *
+     * Settlement keeper entry point. Walks the byexpiry index of
+     * anchorstate from the oldest unfinalized anchor and settles each
+     * one whose voting window has closed, exactly as finalize() would.
+     * Stops after max_items anchors or at the first anchor still open,
+     * and writes globals once at the end.
+     *
+     * @param max_items - Maximum anchors to finalize (1-50)
+     */
+    ACTION crank(uint32_t max_items) {
+        PERF_ACTION("crank"_n);
+        // Anyone can crank; only expired anchors are touched
 
-        // Distribute escrowed tokens based on outcome
-        if(escrowed_amount > 0) {
-            if(accepted) {
-                distribute_rewards_approved(anchor_itr->author, tx_hash, escrowed_amount);
-            } else {
-                distribute_rewards_rejected(tx_hash, escrowed_amount, up_votes, down_votes);
+        auto g = get_globals();
+        check(!g.paused, "Contract is paused");
+        check(max_items > 0 && max_items <= MAX_CRANK_ITEMS, "max_items must be 1-50");
+        require_migrated(g, MIGRATE_VOTES);
+
+        anchorstate_table states(get_self(), get_self().value);
+        votetally_table tallies(get_self(), get_self().value);
+        auto expiry_idx = states.get_index<"byexpiry"_n>();
+        uint32_t now = current_time_point().sec_since_epoch();
+
+        std::vector<settlement_summary> settled;
+        while (settled.size() < max_items) {
+            // Settled anchors move to the finalized half of the index,
+            // so the next candidate is always the first entry
+            auto itr = expiry_idx.begin();
+            PERF_ADD(rows_read, 1);
+            if (itr == expiry_idx.end() || itr->finalized || itr->expires_at > now) break;
+
+            settled.push_back(settle_anchor(g, states, tallies, states.iterator_to(*itr)));
+        }
+
+        check(!settled.empty(), "No expired anchors to finalize");
+
+        globals_singleton globals(get_self(), get_self().value);
+        PERF_ADD(rows_written, 1);
+        globals.set(g, get_self());
+
+        notify("finalevent"_n, settled);
+    }
+
+    /**
+     * @brief Erase settled anchors past the retention period
+     *
+     * Walks the finalized half of the byexpiry index, oldest first, and
+     * erases each anchor's votes, attestations, tag and thread index rows,
+     * tally, settlement state and metadata, returning the RAM to whoever paid for it. Full history stays
+     * available off-chain; a pruneevent notification lists the hashes
+     * removed so indexers can mirror the deletion. Each hash keeps a
+     * prunedhash tombstone (paid by the contract) so it cannot be put
+     * again.
+     *
+     * Vote rows still on the rewarded side are unclaimed shares. Those
+     * shares are forfeited to stakers when the vote row is erased.
+     *
+     * Work is bounded by max_rows (rows erased). An anchor with more rows
+     * than the remaining budget is finished by the next call.
+     *
+     * @param max_rows - Maximum table rows to erase (1-500)
+     */
+    ACTION prune(uint32_t max_rows) {
+        PERF_ACTION("prune"_n);
+        // Anyone can prune; only anchors past retention are touched
+
+        auto g = get_globals();
+        check(!g.paused, "Contract is paused");
+        check(max_rows > 0 && max_rows <= MAX_PRUNE_ROWS, "max_rows must be 1-500");
+        require_migrated(g, MIGRATE_VOTES);
+
+        anchorstate_table states(get_self(), get_self().value);
+        anchors_table anchors(get_self(), get_self().value);
+        votetally_table tallies(get_self(), get_self().value);
+        prunedhash_table pruned(get_self(), get_self().value);
+        auto expiry_idx = states.get_index<"byexpiry"_n>();
+        uint32_t now = current_time_point().sec_since_epoch();
+
+        uint32_t budget = max_rows;
+        uint64_t forfeited = 0;
+        std::vector<checksum256> pruned_hashes;
+
+        while (budget > 0) {
+            auto itr = expiry_idx.lower_bound(uint128_t(1) << 64);
+            PERF_ADD(rows_read, 1);
+            if (itr == expiry_idx.end()) break;
+            // Finalized half is ordered by expiry, so nothing later is due either
+            if (uint64_t(itr->expires_at) + g.prune_retention > now) break;
+
+            uint64_t anchor_id = itr->anchor_id;
+            checksum256 hash = itr->hash;
+            auto tally_itr = tallies.find(anchor_id);
+
+            // Votes, collecting unclaimed shares of the rewarded side
+            votes_table votes(get_self(), anchor_id);
+            auto vote_itr = votes.begin();
+            while (vote_itr != votes.end() && budget > 0) {
+                PERF_ADD(rows_read, 1);
+                PERF_ADD(voters_iterated, 1);
+                if (tally_itr != tallies.end() && tally_itr->rewarded_side != 0 &&
+                    vote_itr->val == tally_itr->rewarded_side) {
+                    forfeited += tally_itr->voter_share;
+                }
+                PERF_ADD(rows_written, 1);
+                vote_itr = votes.erase(vote_itr);
+                budget--;
+            }
+            if (vote_itr != votes.end()) break;
+
+            attestations_table attestations(get_self(), anchor_id);
+            auto att_itr = attestations.begin();
+            while (att_itr != attestations.end() && budget > 0) {
+                PERF_ADD(rows_written, 1);
+                att_itr = attestations.erase(att_itr);
+                budget--;
+            }
+            if (att_itr != attestations.end()) break;
+
+            // This anchor's own thread index (the replies themselves stay)
+            children_table children(get_self(), anchor_id);
+            auto child_itr = children.begin();
+            while (child_itr != children.end() && budget > 0) {
+                PERF_ADD(rows_written, 1);
+                child_itr = children.erase(child_itr);
+                budget--;
+            }
+            if (child_itr != children.end()) break;
+
+            // Tag and thread index rows, metadata, tally and finally the state,
+            // one row per budget unit. Each is looked up again, so an anchor
+            // cut short here resumes where it stopped on the next call.
+            auto anchor_itr = anchors.find(anchor_id);
+            if (anchor_itr != anchors.end()) {
+                for (const auto& tag : anchor_itr->tags) {
+                    if (budget == 0) break;
+                    tagindex_table tag_rows(get_self(), tag.value);
+                    auto tag_itr = tag_rows.find(anchor_itr->seq);
+                    if (tag_itr != tag_rows.end()) {
+                        PERF_ADD(rows_written, 1);
+                        tag_rows.erase(tag_itr);
+                        budget--;
+                    }
+                }
+                if (budget > 0 && anchor_itr->parent.has_value()) {
+                    if (unlink_child(states, anchor_itr->parent.value(), anchor_itr->seq)) budget--;
+                }
+                if (budget == 0) break;
+                PERF_ADD(rows_written, 1);
+                anchors.erase(anchor_itr);
+                budget--;
+            }
+            if (tally_itr != tallies.end()) {
+                if (budget == 0) break;
+                PERF_ADD(rows_written, 1);
+                tallies.erase(tally_itr);
+                budget--;
+            }
+            if (budget == 0) break;
+            // The state row gives way to a tombstone, so put() still rejects the hash
+            auto pruned_probe = probe_hash_key(pruned, hash, &pruned_hash::hash);
+            if (pruned_probe.first == pruned.end()) {
+                PERF_ADD(rows_written, 1);
+                pruned.emplace(get_self(), [&](auto& t) {
+                    t.id = pruned_probe.second;
+                    t.hash = hash;
+                    PERF_RAM(t);
+                });
             }
+            release_hash_key(states, anchor_id, hash);
+            PERF_ADD(rows_written, 1);
+            expiry_idx.erase(itr);
+            budget--;
+
+            pruned_hashes.push_back(hash);
         }
 
-        // Mark as finalized and zero out escrow
-        hash_idx.modify(anchor_itr, same_payer, [&](auto& a) {
-            a.finalized = true;
-            a.escrowed_amount = 0;
-        });
+        check(budget < max_rows, "Nothing to prune");
+
+        // Unclaimed voter shares go to stakers (stay in contract if none)
+        if (forfeited > 0 && g.total_staked > 0) {
+            distribute_to_stakers(g, forfeited);
+            globals_singleton globals(get_self(), get_self().value);
+            PERF_ADD(rows_written, 1);
+            globals.set(g, get_self());
+        }
+
+        if (!pruned_hashes.empty()) {
+            notify("pruneevent"_n, pruned_hashes);
+        }
+    }
+
+    /**
+     * @brief Claim a voter's share of a finalized anchor's reward
+     *
+     * finalize() records the per-voter share and the rewarded side on the
+     * tally row. Voters on that side claim their share here, using their
+     * vote record as proof. The vote record is erased on claim, which
+     * prevents double claims and returns its RAM to the voter. The share is
+     * credited to the voter's balance (see withdraw).
+     *
+     * @param voter - Account that voted on the anchor (must be authorized)
+     * @param tx_hash - Hash of the finalized event
+     */
+    ACTION claimvote(name voter, checksum256 tx_hash) {
+        PERF_ACTION("claimvote"_n);
+        require_auth(voter);
+        auto g = get_globals();
+        require_migrated(g, MIGRATE_VOTES);
+
+        anchorstate_table states(get_self(), get_self().value);
+        auto anchor_itr = find_anchor_state(states, tx_hash);
+        check(anchor_itr != states.end(), "Anchor not found");
+        check(anchor_itr->finalized, "Anchor not finalized yet");
+
+        votetally_table tallies(get_self(), get_self().value);
+        auto tally_itr = tallies.find(anchor_itr->anchor_id);
+        check(tally_itr != tallies.end(), "Vote tally not found for anchor");
+        check(tally_itr->rewarded_side != 0 && tally_itr->voter_share > 0,
+              "No voter rewards for this anchor");
+
+        votes_table votes(get_self(), anchor_itr->anchor_id);
+        auto vote_itr = votes.find(voter.value);
+        check(vote_itr != votes.end(), "No unclaimed vote found for this anchor");
+        check(vote_itr->val == tally_itr->rewarded_side, "Vote was not on the rewarded side");
+
+        // Consume the proof: an erased vote cannot be claimed twice
+        PERF_ADD(rows_written, 1);
+        votes.erase(vote_itr);
+
+        credit_balance(g, voter, tally_itr->voter_share, voter);
     }
 
     // ============ STAKING ON GRAPH NODES ============
@@ -767,6 +1432,7 @@ public:
      * @param quantity - Amount of tokens to stake
      */
     ACTION stake(name account, checksum256 node_id, asset quantity) {
+        PERF_ACTION("stake"_n);
         require_auth(account);
 
         // Check if contract is paused
@@ -775,77 +1441,83 @@ public:
 
         check(quantity.symbol == g.token_symbol, "Invalid token symbol");
         check(quantity.amount > 0, "Must stake positive amount");
+        require_migrated(g, MIGRATE_STAKES);
 
         // Transfer tokens from account to contract
-        transfer_tokens(account, get_self(), quantity,
+        transfer_tokens(g, account, get_self(), quantity,
                        "Stake on node " + checksum_to_hex(node_id).substr(0, 16));
 
-        // Update individual stake record (for user's portfolio view)
+        // Update the account's position on the node
         stakes_table stakes(get_self(), account.value);
-        auto stakes_by_node = stakes.get_index<"bynode"_n>();
-        auto itr = stakes_by_node.find(node_id);
+        auto stake_probe = probe_hash_key(stakes, node_id, &stake_record::node_id);
+        auto itr = stake_probe.first;
+        uint64_t stake_key = stake_probe.second;
 
-        bool is_new_staker = (itr == stakes_by_node.end());
+        bool is_new_staker = (itr == stakes.end());
 
         if (is_new_staker) {
-            stakes.emplace(account, [&](auto& s) {
-                s.id = stakes.available_primary_key();
+            // New position starts earning from the current accumulator
+            PERF_ADD(rows_written, 1);
+            itr = stakes.emplace(account, [&](auto& s) {
+                s.id = stake_key;
                 s.node_id = node_id;
                 s.amount = quantity;
                 s.staked_at = current_time_point();
                 s.last_updated = current_time_point();
+                s.reward_snapshot = g.reward_per_stake;
+                PERF_RAM(s);
             });
         } else {
-            auto pk_itr = stakes.iterator_to(*itr);
-            stakes.modify(pk_itr, account, [&](auto& s) {
+            // Settle rewards earned at the old amount before the stake changes
+            uint64_t accrued = accrued_reward(*itr, g);
+            if(accrued > 0) {
+                credit_pending_reward(account, node_id, asset(accrued, g.token_symbol));
+            }
+
+            PERF_ADD(rows_written, 1);
+            stakes.modify(itr, account, [&](auto& s) {
                 s.amount += quantity;
                 s.last_updated = current_time_point();
+                s.reward_snapshot = g.reward_per_stake;
             });
         }
 
         // Update aggregate for the node (used for voting power and rewards)
         nodeagg_table aggregates(get_self(), get_self().value);
-        auto agg_by_node = aggregates.get_index<"bynode"_n>();
-        auto agg_itr = agg_by_node.find(node_id);
-
-        if (agg_itr == agg_by_node.end()) {
+        auto agg_probe = probe_hash_key(aggregates, node_id, &node_aggregate::node_id);
+        auto agg_itr = agg_probe.first;
+        uint64_t agg_key = agg_probe.second;
+
+        asset node_total = quantity;
+        uint32_t staker_count = 1;
+        if (agg_itr == aggregates.end()) {
+            PERF_ADD(rows_written, 1);
             aggregates.emplace(account, [&](auto& a) {
-                a.id = aggregates.available_primary_key();
+                a.id = agg_key;
                 a.node_id = node_id;
                 a.total = quantity;
                 a.staker_count = 1;
+                PERF_RAM(a);
             });
         } else {
-            auto agg_pk_itr = aggregates.iterator_to(*agg_itr);
-            aggregates.modify(agg_pk_itr, account, [&](auto& a) {
+            PERF_ADD(rows_written, 1);
+            aggregates.modify(agg_itr, account, [&](auto& a) {
                 a.total += quantity;
                 if (is_new_staker) {
                     a.staker_count += 1;
                 }
             });
+            node_total = agg_itr->total;
+            staker_count = agg_itr->staker_count;
         }
 
+        // Track global stake total (denominator of the reward accumulator)
+        g.total_staked += quantity.amount;
+        globals_singleton globals(get_self(), get_self().value);
+        PERF_ADD(rows_written, 1);
+        globals.set(g, get_self());
 
-        // Update staker tracking for reward distribution
-        staker_nodes_table staker_nodes(get_self(), get_self().value);
-        auto sn_idx = staker_nodes.get_index<"byaccnode"_n>();
-        uint128_t composite_key = combine_keys(account.value, node_id);
-        auto sn_itr = sn_idx.find(composite_key);
-
-        if(sn_itr == sn_idx.end()) {
-            // New staker on this node
-            staker_nodes.emplace(account, [&](auto& sn) {
-                sn.id = staker_nodes.available_primary_key();
-                sn.account = account;
-                sn.node_id = node_id;
-                sn.amount = quantity;
-            });
-        } else {
-            // Update existing staker record
-            sn_idx.modify(sn_itr, account, [&](auto& sn) {
-                sn.amount += quantity;
-            });
-        }
+        notify("stakeevent"_n, account, node_id, quantity, itr->amount, node_total, staker_count);
     }
 
     /**
@@ -856,39 +1528,47 @@ public:
      * @param quantity - Amount to unstake
      */
     ACTION unstake(name account, checksum256 node_id, asset quantity) {
+        PERF_ACTION("unstake"_n);
         require_auth(account);
         auto g = get_globals();
         check(quantity.symbol == g.token_symbol, "Invalid token symbol");
         check(quantity.amount > 0, "Must unstake positive amount");
+        require_migrated(g, MIGRATE_STAKES);
 
-        // Update individual stake
+        // Update the account's position on the node
         stakes_table stakes(get_self(), account.value);
-        auto stakes_by_node = stakes.get_index<"bynode"_n>();
-        auto itr = stakes_by_node.find(node_id);
-        check(itr != stakes_by_node.end(), "No stake found for this node");
-
-        auto stake_pk_itr = stakes.iterator_to(*itr);
+        auto stake_pk_itr = find_by_hash_key(stakes, node_id, &stake_record::node_id);
+        check(stake_pk_itr != stakes.end(), "No stake found for this node");
         check(stake_pk_itr->amount >= quantity, "Insufficient stake");
 
         bool removing_all = (stake_pk_itr->amount == quantity);
+        asset position = stake_pk_itr->amount - quantity;
+
+        // Settle rewards earned at the old amount before the stake changes
+        uint64_t accrued = accrued_reward(*stake_pk_itr, g);
+        if(accrued > 0) {
+            credit_pending_reward(account, node_id, asset(accrued, g.token_symbol));
+        }
 
         if (removing_all) {
+            release_hash_key(stakes, stake_pk_itr->id, node_id);
+            PERF_ADD(rows_written, 1);
             stakes.erase(stake_pk_itr);
         } else {
+            PERF_ADD(rows_written, 1);
             stakes.modify(stake_pk_itr, account, [&](auto& s) {
                 s.amount -= quantity;
                 s.last_updated = current_time_point();
+                s.reward_snapshot = g.reward_per_stake;
             });
         }
 
         // Update aggregate
         nodeagg_table aggregates(get_self(), get_self().value);
-        auto agg_by_node = aggregates.get_index<"bynode"_n>();
-        auto agg_itr = agg_by_node.find(node_id);
-        check(agg_itr != agg_by_node.end(), "Aggregate not found");
-        auto agg_pk_itr = aggregates.iterator_to(*agg_itr);
-
+        auto agg_pk_itr = find_by_hash_key(aggregates, node_id, &node_aggregate::node_id);
+        check(agg_pk_itr != aggregates.end(), "Aggregate not found");
 
+        PERF_ADD(rows_written, 1);
         aggregates.modify(agg_pk_itr, account, [&](auto& a) {
             a.total -= quantity;
             // Only decrement staker count if removing all stake
@@ -897,204 +1577,641 @@ public:
             }
         });
 
+        asset node_total = agg_pk_itr->total;
+        uint32_t staker_count = agg_pk_itr->staker_count;
+
         // Remove aggregate if no more stakers
-        if (agg_itr->staker_count == 0) {
+        if (agg_pk_itr->staker_count == 0) {
+            release_hash_key(aggregates, agg_pk_itr->id, node_id);
+            PERF_ADD(rows_written, 1);
             aggregates.erase(agg_pk_itr);
         }
 
-
-        // Update staker tracking
-        staker_nodes_table staker_nodes(get_self(), get_self().value);
-        auto sn_idx = staker_nodes.get_index<"byaccnode"_n>();
-        uint128_t composite_key = combine_keys(account.value, node_id);
-        auto sn_itr = sn_idx.require_find(composite_key, "Staker node tracking not found");
-
-        if(removing_all) {
-            // Remove staker tracking record
-            sn_idx.erase(sn_itr);
-        } else {
-            // Update amount in tracking record
-            sn_idx.modify(sn_itr, account, [&](auto& sn) {
-                sn.amount -= quantity;
-            });
-        }
+        // Track global stake total (denominator of the reward accumulator).
+        // migrate() seeds it from every pre-existing position; the clamp
+        // keeps a position the total never counted from underflowing it.
+        g.total_staked -= std::min<uint64_t>(g.total_staked, quantity.amount);
+        globals_singleton globals(get_self(), get_self().value);
+        PERF_ADD(rows_written, 1);
+        globals.set(g, get_self());
 
         // Transfer tokens back to account
-        transfer_tokens(get_self(), account, quantity, "Unstake from node");
+        transfer_tokens(g, get_self(), account, quantity, "Unstake from node");
+
+        notify("stakeevent"_n, account, node_id, -quantity, position, node_total, staker_count);
     }
 
     /**
      * @brief Claim pending staker rewards for a specific node
      *
      * When submissions are rejected, 50% of emission goes to stakers.
-     * These rewards accumulate as pending and must be claimed.
+     * Rewards accrue lazily through the global reward-per-stake accumulator
+     * and are settled here, together with any balance already recorded
+     * (settled on stake/unstake into pendingrwd2, or left in pendingrwd by
+     * the pre-accumulator distribution). The total is credited to the
+     * account's balance (see withdraw).
      *
      * @param account - Account claiming rewards (must be authorized)
      * @param node_id - Node to claim rewards from
      */
     ACTION claimreward(name account, checksum256 node_id) {
+        PERF_ACTION("claimreward"_n);
         require_auth(account);
+        auto g = get_globals();
+        require_migrated(g, MIGRATE_STAKES);
 
-        // Get pending rewards for this account and node
+        uint64_t reward_amount = 0;
+
+        // Previously settled pending rewards for this account and node
         pending_rewards_table pending(get_self(), account.value);
-        auto pending_by_node = pending.get_index<"bynode"_n>();
-        auto itr = pending_by_node.find(node_id);
-        check(itr != pending_by_node.end(), "No pending rewards for this node");
-        auto pending_pk_itr = pending.iterator_to(*itr);
+        auto itr = find_by_hash_key(pending, node_id, &pending_reward::node_id);
+        if(itr != pending.end()) {
+            reward_amount += itr->amount.amount;
+            release_hash_key(pending, itr->id, node_id);
+            PERF_ADD(rows_written, 1);
+            pending.erase(itr);
+        }
+
+        // Balance recorded by the schema 1 distribution (account-scoped, never migrated)
+        legacy_pending_rewards_table legacy_pending(get_self(), account.value);
+        auto legacy_by_node = legacy_pending.get_index<"bynode"_n>();
+        PERF_ADD(rows_read, 1);
+        auto legacy_itr = legacy_by_node.find(node_id);
+        if(legacy_itr != legacy_by_node.end()) {
+            reward_amount += legacy_itr->amount.amount;
+            PERF_ADD(rows_written, 1);
+            legacy_by_node.erase(legacy_itr);
+        }
+
+        // Rewards accrued on the live position since its last settlement
+        stakes_table stakes(get_self(), account.value);
+        auto stake_itr = find_by_hash_key(stakes, node_id, &stake_record::node_id);
+        if(stake_itr != stakes.end()) {
+            uint64_t accrued = accrued_reward(*stake_itr, g);
+            if(accrued > 0) {
+                reward_amount += accrued;
+                PERF_ADD(rows_written, 1);
+                stakes.modify(stake_itr, same_payer, [&](auto& s) {
+                    s.reward_snapshot = g.reward_per_stake;
+                });
+            }
+        }
 
-        asset reward_amount = pending_pk_itr->amount;
-        check(reward_amount.amount > 0, "No rewards to claim");
+        check(reward_amount > 0, "No pending rewards for this node");
 
-        // Remove the pending reward record
-        pending.erase(pending_pk_itr);
-        // Transfer tokens from contract escrow to the staker
-        transfer_tokens(get_self(), account, reward_amount,
-                    "Staker reward from node " + checksum_to_hex(node_id).substr(0, 16));
+        credit_balance(g, account, reward_amount, account);
     }
 
     /**
-     * @brief Claim all pending staker rewards across all nodes
+     * @brief Claim pending staker rewards across all nodes, a bounded slice at a time
      *
-     * Convenience function to claim from all nodes at once.
+     * Drains recorded pending reward balances first (erased as they are
+     * claimed, schema 1 rows included), then settles live positions against the reward
+     * accumulator, visiting at most max_rows rows in total. The slice is
+     * credited to the account's balance once (see withdraw). Where the
+     * position walk stopped is kept on the balance row, so repeating the
+     * call resumes there; it returns 0 once a full pass is done.
      *
      * @param account - Account claiming rewards (must be authorized)
+     * @param max_rows - Maximum pendingrwd and stake rows to visit (1-100)
+     * @return Rows left in the current pass, counted at most max_rows ahead
      */
-    ACTION claimall(name account) {
+    [[eosio::action]]
+    uint32_t claimall(name account, uint32_t max_rows) {
+        PERF_ACTION("claimall"_n);
         require_auth(account);
-
-        pending_rewards_table pending(get_self(), account.value);
+        check(max_rows > 0 && max_rows <= MAX_CLAIM_ROWS, "max_rows must be between 1 and 100");
+        auto g = get_globals();
+        require_migrated(g, MIGRATE_STAKES);
 
         uint64_t total_claimed = 0;
-        uint32_t node_count = 0;
+        uint32_t rows = 0;
+
+        // Drain balances recorded by the schema 1 distribution (never migrated)
+        legacy_pending_rewards_table legacy_pending(get_self(), account.value);
+        auto legacy_itr = legacy_pending.begin();
+        while(legacy_itr != legacy_pending.end() && rows < max_rows) {
+            PERF_ADD(rows_read, 1);
+            total_claimed += legacy_itr->amount.amount;
+            PERF_ADD(rows_written, 1);
+            legacy_itr = legacy_pending.erase(legacy_itr);
+            ++rows;
+        }
 
-        // Collect all rewards (avoid iterator invalidation)
-        std::vector<std::pair<checksum256, asset>> rewards_to_claim;
-        for(auto itr = pending.begin(); itr != pending.end(); ++itr) {
+        // Drain previously settled pending reward records
+        pending_rewards_table pending(get_self(), account.value);
+        auto itr = pending.begin();
+        while(itr != pending.end() && rows < max_rows) {
+            PERF_ADD(rows_read, 1);
             if(itr->amount.amount > 0) {
-                rewards_to_claim.push_back({itr->node_id, itr->amount});
                 total_claimed += itr->amount.amount;
-                node_count++;
             }
+            release_hash_key(pending, itr->id, itr->node_id);
+            PERF_ADD(rows_written, 1);
+            itr = pending.erase(itr);
+            ++rows;
         }
 
-        check(total_claimed > 0, "No pending rewards to claim");
+        // Settle accrued rewards on live positions, resuming at the cursor
+        balances_table balances(get_self(), get_self().value);
+        auto bal_itr = balances.find(account.value);
+        uint64_t cursor = (bal_itr != balances.end()) ? bal_itr->claim_cursor : 0;
 
-        // Remove all pending reward records
-        auto itr = pending.begin();
-        while(itr != pending.end()) {
-            itr = pending.erase(itr);
+        stakes_table stakes(get_self(), account.value);
+        auto stake_itr = stakes.lower_bound(cursor);
+        for(; stake_itr != stakes.end() && rows < max_rows; ++stake_itr, ++rows) {
+            PERF_ADD(rows_read, 1);
+            PERF_ADD(stakers_iterated, 1);
+            uint64_t accrued = accrued_reward(*stake_itr, g);
+            if(accrued == 0) continue;
+
+            total_claimed += accrued;
+            PERF_ADD(rows_written, 1);
+            stakes.modify(stake_itr, same_payer, [&](auto& s) {
+                s.reward_snapshot = g.reward_per_stake;
+            });
+        }
+        uint64_t next_cursor = (stake_itr != stakes.end()) ? stake_itr->id : 0;
+
+        check(rows > 0, "No pending rewards to claim");
+
+        // Count what is left of this pass, without reading further than one more slice
+        uint32_t remaining = 0;
+        for(; legacy_itr != legacy_pending.end() && remaining < max_rows; ++legacy_itr) ++remaining;
+        for(; itr != pending.end() && remaining < max_rows; ++itr) ++remaining;
+        for(; stake_itr != stakes.end() && remaining < max_rows; ++stake_itr) ++remaining;
+
+        credit_balance(g, account, total_claimed, account);
+
+        bal_itr = balances.find(account.value);
+        if(bal_itr != balances.end()) {
+            if(next_cursor == 0 && bal_itr->balance.amount == 0) {
+                // Sweep done and nothing left to withdraw: free the cursor row
+                PERF_ADD(rows_written, 1);
+                balances.erase(bal_itr);
+            } else if(bal_itr->claim_cursor != next_cursor) {
+                PERF_ADD(rows_written, 1);
+                balances.modify(bal_itr, same_payer, [&](auto& b) {
+                    b.claim_cursor = next_cursor;
+                });
+            }
+        } else if(next_cursor != 0) {
+            // Nothing credited yet, but the walk has to resume mid-scope
+            PERF_ADD(rows_written, 1);
+            balances.emplace(account, [&](auto& b) {
+                b.account = account;
+                b.balance = asset(0, g.token_symbol);
+                b.last_updated = current_time_point();
+                b.claim_cursor = next_cursor;
+                PERF_RAM(b);
+            });
         }
 
-        // Transfer total rewards from contract escrow in single transaction
-        auto g = get_globals();
-        transfer_tokens(get_self(), account, asset(total_claimed, g.token_symbol),
-                    "Staker rewards from " + std::to_string(node_count) + " nodes");
+        return remaining;
     }
 
     /**
-     * @brief Initialize contract state
+     * @brief Withdraw the account's credited reward balance
      *
-     * @param oracle - Initial Fractally oracle account
-     * @param token_contract - Token contract for MUS token
+     * Author rewards, voter shares and staker rewards are credited to an
+     * internal balance instead of being transferred one by one. This moves
+     * the whole balance out in a single token transfer and frees the row,
+     * unless it still holds a claimall() cursor. Escrow is only issued for the part the contract's liquid balance
+     * (less staked principal) cannot cover; the rest stays deferred.
+     *
+     * @param account - Account withdrawing (must be authorized)
      */
-    ACTION init(name oracle, name token_contract, symbol token_symbol) {
-        require_auth(get_self());
+    ACTION withdraw(name account) {
+        PERF_ACTION("withdraw"_n);
+        require_auth(account);
+        auto g = get_globals();
 
-        globals_singleton globals(get_self(), get_self().value);
-        check(!globals.exists(), "Already initialized");
+        balances_table balances(get_self(), get_self().value);
+        auto itr = balances.find(account.value);
+        check(itr != balances.end() && itr->balance.amount > 0, "No balance to withdraw");
 
-        // Validate oracle account exists
-        check(is_account(oracle), "Oracle account does not exist");
+        asset quantity = itr->balance;
+        if (itr->claim_cursor != 0) {
+            // A claimall() sweep is mid-way: keep its cursor
+            PERF_ADD(rows_written, 1);
+            balances.modify(itr, same_payer, [&](auto& b) {
+                b.balance.amount = 0;
+            });
+        } else {
+            PERF_ADD(rows_written, 1);
+            balances.erase(itr);
+        }
 
-        // Validate token contract exists
-        check(is_account(token_contract), "Token contract account does not exist");
-        check(token_contract != get_self(), "Token contract cannot be self");
+        // Rewards are paid out of issued escrow; staked principal is not theirs
+        if (g.unissued_escrow > 0) {
+            int64_t liquid = get_token_balance(g.token_contract, get_self(), g.token_symbol).amount;
+            uint64_t available = liquid > 0 ? static_cast<uint64_t>(liquid) : 0;
+            available -= std::min(available, g.total_staked);
+            uint64_t needed = static_cast<uint64_t>(quantity.amount);
+            if (needed > available) {
+                issue_escrow(g, needed - available);
+                globals_singleton globals(get_self(), get_self().value);
+                PERF_ADD(rows_written, 1);
+                globals.set(g, get_self());
+            }
+        }
 
-        // Validate token symbol
-        check(token_symbol.is_valid(), "Invalid token symbol");
-        check(token_symbol.precision() <= 18, "Token precision too high (max 18)");
+        transfer_tokens(g, get_self(), account, quantity, "Polaris reward withdrawal");
+    }
 
-        // Validate token contract implements eosio.token interface for configured symbol
-        validate_token_contract(token_contract, token_symbol);
+    /**
+     * @brief Issue the escrow accumulated since the last issuance
+     *
+     * put() and putbatch() only add their mint to unissued_escrow; the
+     * token contract's supply is brought up to date here in a single
+     * issue, or by the next withdraw() that needs the liquidity. Keepers
+     * can call this periodically so withdrawals rarely have to.
+     */
+    ACTION issueepoch() {
+        PERF_ACTION("issueepoch"_n);
+        // Anyone can trigger issuance; the amount is fixed by put()
 
-        global_state g;
-        g.x = 1; // Start at 1 to avoid log(0)
-        g.carry = 0.0;
-        g.round = 0;
-        g.fractally_oracle = oracle;
-        g.token_contract = token_contract;
-        g.token_symbol = token_symbol;
+        auto g = get_globals();
+        check(!g.paused, "Contract is paused");
+        check(g.unissued_escrow > 0, "No escrow to issue");
 
-        // Initialize governance parameters with defaults
-        g.approval_threshold_bp = 9000;  // 90% approval required
-        g.max_vote_weight = 100;         // Cap voting weight at 100 Respect
-        g.attestor_respect_threshold = 50; // Require 50 Respect to attest
+        issue_escrow(g, g.unissued_escrow);
 
+        globals_singleton globals(get_self(), get_self().value);
+        PERF_ADD(rows_written, 1);
         globals.set(g, get_self());
     }
 
+    // ============ READ-ONLY QUERIES ============
+
     /**
-     * @brief Reinitialize contract configuration (recovery from init errors)
-     *
-     * Allows contract owner to fix configuration errors after initial deployment
-     * without requiring contract redeployment. Only updates oracle and token_contract.
-     * Does NOT reset x, carry, round, or governance parameters.
+     * @brief Look up an anchor by event hash, together with its vote tally
      *
-     * @param oracle - Fractally oracle account (updates Respect values)
-     * @param token_contract - Token contract account (MUS token)
+     * Read-only: evaluated by send_read_only_transaction, never recorded.
+     * Saves API clients from probing anchor, anchorstate and votetally
+     * rows one get_table_rows call at a time. While migrate() is running,
+     * anchors it has not rekeyed yet are served from their schema 1 row.
      *
-     * @pre Contract must be initialized
-     * @pre Requires contract authority
-     * @pre Oracle and token_contract must be valid accounts
+     * @param tx_hash - Hash of the anchored event
      */
-    ACTION reinit(name oracle, name token_contract, symbol token_symbol) {
-        require_auth(get_self());
-
-        globals_singleton globals(get_self(), get_self().value);
-        check(globals.exists(), "Contract not initialized - use init() first");
-
-        // Validate oracle account exists
-        check(is_account(oracle), "Oracle account does not exist");
-
-        // Validate token contract exists
-        check(is_account(token_contract), "Token contract account does not exist");
-        check(token_contract != get_self(), "Token contract cannot be self");
+    [[eosio::action, eosio::read_only]]
+    anchor_view getanchor(checksum256 tx_hash) {
+        anchorstate_table states(get_self(), get_self().value);
+        auto state_itr = find_anchor_state(states, tx_hash);
+        if (state_itr == states.end()) {
+            // Not rekeyed by migrate() yet: serve it from the schema 1 row
+            auto legacy_view = find_legacy_anchor(tx_hash);
+            check(legacy_view.has_value(), "Anchor not found");
+            return legacy_view.value();
+        }
 
-        // Validate token symbol
-        check(token_symbol.is_valid(), "Invalid token symbol");
-        check(token_symbol.precision() <= 18, "Token precision too high (max 18)");
+        anchors_table anchors(get_self(), get_self().value);
+        const auto& a = anchors.get(state_itr->anchor_id, "Anchor metadata not found");
+
+        anchor_view view{};
+        view.anchor_id = a.id;
+        view.seq = a.seq;
+        view.author = a.author;
+        view.type = a.type;
+        view.hash = a.hash;
+        view.event_cid = a.event_cid;
+        view.parent = a.parent;
+        view.ts = a.ts;
+        view.tags = a.tags;
+        view.expires_at = state_itr->expires_at;
+        view.finalized = state_itr->finalized;
+        view.escrowed_amount = state_itr->escrowed_amount;
+        view.submission_x = state_itr->submission_x;
 
-        // Validate token contract implements eosio.token interface for configured symbol
-        validate_token_contract(token_contract, token_symbol);
+        votetally_table tallies(get_self(), get_self().value);
+        auto tally_itr = tallies.find(a.id);
+        if (tally_itr != tallies.end()) {
+            view.up_weight = tally_itr->up_weight;
+            view.down_weight = tally_itr->down_weight;
+            view.up_voter_count = tally_itr->up_voter_count;
+            view.down_voter_count = tally_itr->down_voter_count;
+            view.rewarded_side = tally_itr->rewarded_side;
+            view.voter_share = tally_itr->voter_share;
+        }
 
-        auto g = globals.get();
+        return view;
+    }
 
-        // If changing token_contract or token_symbol, enforce economy-empty safety
-        bool changing_token = (token_contract != g.token_contract || token_symbol != g.token_symbol);
-        if (changing_token) {
-            check(g.paused, "Contract must be paused before changing token config (call pause() first)");
+    /**
+     * @brief List unfinalized anchors, oldest expiry first
+     *
+     * Walks the byexpiry index, so expired anchors (the ones crank() would
+     * settle next) come first. Pages resume at the (expires_at, anchor_id)
+     * position the index orders by, so an anchor settled or pruned between
+     * two pages does not break paging.
+     *
+     * @param start_expires_at - Expiry to start from (next_expires_at of the previous page, 0 = first page)
+     * @param start_id - First anchor ID to include at start_expires_at (next_id of the previous page)
+     * @param limit - Maximum rows to return (1-100)
+     */
+    [[eosio::action, eosio::read_only]]
+    open_anchor_page getopen(uint32_t start_expires_at, uint64_t start_id, uint32_t limit) {
+        check(limit > 0 && limit <= MAX_QUERY_ROWS, "limit must be between 1 and 100");
+        require_migrated(get_globals(), MIGRATE_ANCHORS);
+
+        anchorstate_table states(get_self(), get_self().value);
+        auto expiry_idx = states.get_index<"byexpiry"_n>();
+        // Ties on expires_at are ordered by primary key
+        auto itr = expiry_idx.lower_bound(uint128_t(start_expires_at));
+        while (itr != expiry_idx.end() && !itr->finalized &&
+               itr->expires_at == start_expires_at && itr->anchor_id < start_id) {
+            PERF_ADD(rows_read, 1);
+            ++itr;
+        }
 
-            // Ensure no active stakes
-            nodeagg_table aggregates(get_self(), get_self().value);
-            check(aggregates.begin() == aggregates.end(),
-                  "Cannot change token: active stakes exist (unstake all first)");
+        open_anchor_page page{};
+        for (; itr != expiry_idx.end() && !itr->finalized; ++itr) {
+            if (page.rows.size() == limit) {
+                page.next_expires_at = itr->expires_at;
+                page.next_id = itr->anchor_id;
+                break;
+            }
+            page.rows.push_back(open_anchor{itr->anchor_id, itr->hash, itr->author, itr->type,
+                                            itr->expires_at, itr->escrowed_amount});
+        }
 
-            staker_nodes_table staker_nodes(get_self(), get_self().value);
-            check(staker_nodes.begin() == staker_nodes.end(),
-                  "Cannot change token: staker node records exist");
+        return page;
+    }
 
-            // Ensure no unfinalized escrows with balance
-            anchors_table anchors(get_self(), get_self().value);
-            for (auto itr = anchors.begin(); itr != anchors.end(); ++itr) {
-                check(itr->finalized || itr->escrowed_amount == 0,
-                      "Cannot change token: unfinalized escrows with balance exist (finalize all first)");
+    /**
+     * @brief List anchors carrying a tag, most recent first
+     *
+     * Walks the tag's tagindex scope backwards from before_seq and joins
+     * each row with its settlement state.
+     *
+     * @param tag - Tag to look up
+     * @param before_seq - Only anchors submitted before this seq (next_seq of the previous page, 0 = newest)
+     * @param limit - Maximum rows to return (1-100)
+     */
+    [[eosio::action, eosio::read_only]]
+    anchor_ref_page gettag(name tag, uint64_t before_seq, uint32_t limit) {
+        check(limit > 0 && limit <= MAX_QUERY_ROWS, "limit must be between 1 and 100");
+        require_migrated(get_globals(), MIGRATE_ANCHORS);
+
+        tagindex_table tag_rows(get_self(), tag.value);
+        anchorstate_table states(get_self(), get_self().value);
+        auto itr = (before_seq == 0) ? tag_rows.end() : tag_rows.lower_bound(before_seq);
+
+        anchor_ref_page page{};
+        while (itr != tag_rows.begin()) {
+            --itr;
+            if (page.rows.size() == limit) {
+                // Older rows remain; the last returned seq is the next page's bound
+                page.next_seq = page.rows.back().seq;
+                break;
             }
+            auto state_itr = states.find(itr->anchor_id);
+            if (state_itr == states.end()) continue;
+            page.rows.push_back(anchor_ref{itr->anchor_id, itr->seq, state_itr->hash, state_itr->author,
+                                           state_itr->type, state_itr->finalized});
+        }
 
-            // Ensure contract balance of old token is zero
-            auto old_balance = get_token_balance(g.token_contract, get_self(), g.token_symbol.code());
-            check(old_balance.amount == 0,
+        return page;
+    }
+
+    /**
+     * @brief List the direct replies to an anchor, oldest first
+     *
+     * Walks the parent's children scope and joins each row with its
+     * settlement state. Replies to a reply are listed under that reply.
+     *
+     * @param parent_hash - Hash of the anchor whose thread to load
+     * @param start_seq - Seq to start from (next_seq of the previous page, 0 = first page)
+     * @param limit - Maximum rows to return (1-100)
+     */
+    [[eosio::action, eosio::read_only]]
+    thread_page getthread(checksum256 parent_hash, uint64_t start_seq, uint32_t limit) {
+        check(limit > 0 && limit <= MAX_QUERY_ROWS, "limit must be between 1 and 100");
+        require_migrated(get_globals(), MIGRATE_ANCHORS);
+
+        anchorstate_table states(get_self(), get_self().value);
+        auto parent_itr = find_anchor_state(states, parent_hash);
+        check(parent_itr != states.end(), "Anchor not found");
+
+        thread_page page{};
+        page.parent_id = parent_itr->anchor_id;
+        page.child_count = parent_itr->child_count;
+        page.last_child_at = parent_itr->last_child_at;
+
+        children_table children(get_self(), parent_itr->anchor_id);
+        for (auto itr = children.lower_bound(start_seq); itr != children.end(); ++itr) {
+            if (page.rows.size() == limit) {
+                page.next_seq = itr->seq;
+                break;
+            }
+            auto state_itr = states.find(itr->anchor_id);
+            if (state_itr == states.end()) continue;
+            page.rows.push_back(anchor_ref{itr->anchor_id, itr->seq, state_itr->hash, state_itr->author,
+                                           state_itr->type, state_itr->finalized});
+        }
+
+        return page;
+    }
+
+    /**
+     * @brief List an account's stake positions with claimable rewards
+     *
+     * pending is what claimreward() would credit for the node right now:
+     * the recorded pending balances (schema 1 rows included) plus the
+     * reward accrued since the position's last settlement. Balances left on fully unstaked nodes
+     * stay in the account's pendingrwd scope.
+     *
+     * @param account - Staker account
+     * @param start_id - stakes key to start from (next_id of the previous page, 0 = first page)
+     * @param limit - Maximum positions to return (1-100)
+     */
+    [[eosio::action, eosio::read_only]]
+    portfolio_page getportfolio(name account, uint64_t start_id, uint32_t limit) {
+        check(limit > 0 && limit <= MAX_QUERY_ROWS, "limit must be between 1 and 100");
+        auto g = get_globals();
+        require_migrated(g, MIGRATE_STAKES);
+
+        portfolio_page page{};
+        page.balance = asset(0, g.token_symbol);
+        balances_table balances(get_self(), get_self().value);
+        auto bal_itr = balances.find(account.value);
+        if (bal_itr != balances.end()) {
+            page.balance = bal_itr->balance;
+        }
+
+        stakes_table stakes(get_self(), account.value);
+        auto itr = stakes.lower_bound(start_id);
+
+        pending_rewards_table pending(get_self(), account.value);
+        legacy_pending_rewards_table legacy_pending(get_self(), account.value);
+        auto legacy_by_node = legacy_pending.get_index<"bynode"_n>();
+        for (; itr != stakes.end(); ++itr) {
+            if (page.positions.size() == limit) {
+                page.next_id = itr->id;
+                break;
+            }
+
+            uint64_t claimable = accrued_reward(*itr, g);
+            auto pending_itr = find_by_hash_key(pending, itr->node_id, &pending_reward::node_id);
+            if (pending_itr != pending.end()) {
+                claimable += pending_itr->amount.amount;
+            }
+            auto legacy_itr = legacy_by_node.find(itr->node_id);
+            if (legacy_itr != legacy_by_node.end()) {
+                claimable += legacy_itr->amount.amount;
+            }
+
+            page.positions.push_back(stake_position{itr->node_id, itr->amount,
+                                                    asset(claimable, g.token_symbol)});
+        }
+
+        return page;
+    }
+
+    /**
+     * @brief Stake and like aggregates of a node
+     *
+     * A node nobody has staked on or liked returns zero totals.
+     *
+     * @param node_id - Node identifier
+     */
+    [[eosio::action, eosio::read_only]]
+    node_view getnode(checksum256 node_id) {
+        auto g = get_globals();
+        require_migrated(g, MIGRATE_LIKES);
+
+        node_view view{};
+        view.node_id = node_id;
+        view.total_staked = asset(0, g.token_symbol);
+
+        nodeagg_table aggregates(get_self(), get_self().value);
+        auto agg_itr = find_by_hash_key(aggregates, node_id, &node_aggregate::node_id);
+        if (agg_itr != aggregates.end()) {
+            view.total_staked = agg_itr->total;
+            view.staker_count = agg_itr->staker_count;
+        }
+
+        likeagg_table like_aggs(get_self(), get_self().value);
+        auto like_itr = find_by_hash_key(like_aggs, node_id, &like_aggregate::node_id);
+        if (like_itr != like_aggs.end()) {
+            view.like_count = like_itr->like_count;
+        }
+
+        return view;
+    }
+
+    /**
+     * @brief Initialize contract state
+     *
+     * @param oracle - Initial Fractally oracle account
+     * @param token_contract - Token contract for MUS token
+     */
+    ACTION init(name oracle, name token_contract, symbol token_symbol) {
+        require_auth(get_self());
+
+        globals_singleton globals(get_self(), get_self().value);
+        check(!globals.exists(), "Already initialized");
+        legacy_globals_singleton legacy_globals(get_self(), get_self().value);
+        check(!legacy_globals.exists(), "Already initialized - call migrate() to upgrade the schema");
+
+        // Validate oracle account exists
+        check(is_account(oracle), "Oracle account does not exist");
+
+        // Validate token contract exists
+        check(is_account(token_contract), "Token contract account does not exist");
+        check(token_contract != get_self(), "Token contract cannot be self");
+
+        // Validate token symbol
+        check(token_symbol.is_valid(), "Invalid token symbol");
+        check(token_symbol.precision() <= 18, "Token precision too high (max 18)");
+
+        // Validate token contract implements eosio.token interface for configured symbol
+        validate_token_contract(token_contract, token_symbol);
+
+        global_state g;
+        g.x = 1; // Start at 1 to avoid log(0)
+        g.carry = 0.0;
+        g.carry_q32 = 0;
+        g.round = 0;
+        g.fractally_oracle = oracle;
+        g.token_contract = token_contract;
+        g.token_symbol = token_symbol;
+
+        // Initialize governance parameters with defaults
+        g.approval_threshold_bp = 9000;  // 90% approval required
+        g.max_vote_weight = 100;         // Cap voting weight at 100 Respect
+        g.attestor_respect_threshold = 50; // Require 50 Respect to attest
+
+        // A fresh deployment starts on the current layout
+        g.schema_version = SCHEMA_VERSION;
+
+        globals.set(g, get_self());
+    }
+
+    /**
+     * @brief Reinitialize contract configuration (recovery from init errors)
+     *
+     * Allows contract owner to fix configuration errors after initial deployment
+     * without requiring contract redeployment. Only updates oracle and token_contract.
+     * Does NOT reset x, carry, round, or governance parameters.
+     *
+     * @param oracle - Fractally oracle account (updates Respect values)
+     * @param token_contract - Token contract account (MUS token)
+     *
+     * @pre Contract must be initialized
+     * @pre Requires contract authority
+     * @pre Oracle and token_contract must be valid accounts
+     */
+    ACTION reinit(name oracle, name token_contract, symbol token_symbol) {
+        require_auth(get_self());
+
+        globals_singleton globals(get_self(), get_self().value);
+        check(globals.exists(), "Contract not initialized - use init() first");
+
+        // Validate oracle account exists
+        check(is_account(oracle), "Oracle account does not exist");
+
+        // Validate token contract exists
+        check(is_account(token_contract), "Token contract account does not exist");
+        check(token_contract != get_self(), "Token contract cannot be self");
+
+        // Validate token symbol
+        check(token_symbol.is_valid(), "Invalid token symbol");
+        check(token_symbol.precision() <= 18, "Token precision too high (max 18)");
+
+        // Validate token contract implements eosio.token interface for configured symbol
+        validate_token_contract(token_contract, token_symbol);
+
+        auto g = globals.get();
+
+        // If changing token_contract or token_symbol, enforce economy-empty safety
+        bool changing_token = (token_contract != g.token_contract || token_symbol != g.token_symbol);
+        if (changing_token) {
+            check(g.paused, "Contract must be paused before changing token config (call pause() first)");
+
+            // Ensure no active stakes
+            nodeagg_table aggregates(get_self(), get_self().value);
+            check(aggregates.begin() == aggregates.end(),
+                  "Cannot change token: active stakes exist (unstake all first)");
+
+            check(g.total_staked == 0, "Cannot change token: active stakes exist (unstake all first)");
+
+            balances_table balances(get_self(), get_self().value);
+            check(balances.begin() == balances.end(),
+                  "Cannot change token: unwithdrawn balances exist");
+
+            // Ensure no unfinalized escrows with balance
+            check(g.open_escrow == 0,
+                  "Cannot change token: unfinalized escrows with balance exist (finalize all first)");
+
+            // Ensure contract balance of old token is zero
+            auto old_balance = get_token_balance(g.token_contract, get_self(), g.token_symbol);
+            check(old_balance.amount == 0,
                   "Cannot change token: contract still holds " + old_balance.to_string() +
                   " (drain balance first)");
+
+            // Nothing is owed in the old token any more; drop its pending issuance
+            g.unissued_escrow = 0;
         }
 
         // Update oracle, token_contract, and token_symbol; preserve all other state
@@ -1104,24 +2221,237 @@ public:
         globals.set(g, get_self());
     }
 
+    /**
+     * @brief Bring state written by an earlier build up to SCHEMA_VERSION
+     *
+     * Converts schema 1 rows in bounded slices, so a chain with millions
+     * of rows never needs one oversized transaction. Tables whose layout
+     * changed have new names, so old and new rows never share a table;
+     * each step moves rows from the old table to the new one and erases
+     * them, and the next call resumes at the first row left:
+     *
+     * 1. Globals: copy the configuration into globals2 and seed
+     *    anchor_count; the other running totals start at zero and are
+     *    rebuilt from the rows the later steps walk
+     * 2. Respect: copy Respect values into respect2
+     * 3. Stakes: rekey every position listed in stakernodes into stakes2,
+     *    rebuilding nodeagg2 and total_staked, then drop the old nodeagg
+     * 4. Anchors: rekey anchors in submission order into anchors2 and
+     *    anchorstate with their tag and thread index rows and tally,
+     *    counting open_anchors, open_escrow and settled_votes
+     * 5. Attestations: move them into their anchor's scope and count them
+     * 6. Votes: move the votes of open anchors into their anchor's scope
+     *    (finalized anchors paid their voters at settlement)
+     * 7. Likes: fold the old like counts into likeagg2
+     *
+     * Only actions that depend on rows a step has not converted yet wait
+     * for it (see require_migrated); the others stay live. Schema 1 like
+     * and pending reward rows are scoped by account and cannot be walked,
+     * so like(), unlike(), claimreward(), claimall() and getportfolio()
+     * read them where they are for good, and getanchor() falls back to the
+     * old anchor until step 4 reaches it.
+     *
+     * Rows written here are billed to the contract, because migrate cannot
+     * bill the accounts that owned the old rows.
+     *
+     * @param max_rows - Maximum source rows visited (1-500)
+     * @return Step the next call resumes at, 0 once the schema is current
+     */
+    [[eosio::action]]
+    uint8_t migrate(uint32_t max_rows) {
+        PERF_ACTION("migrate"_n);
+        require_auth(get_self());
+        check(max_rows > 0 && max_rows <= MAX_MIGRATE_ROWS, "max_rows must be 1-500");
+
+        globals_singleton globals(get_self(), get_self().value);
+        migration_singleton migration(get_self(), get_self().value);
+        uint32_t budget = max_rows;
+
+        global_state g;
+        migration_state m;
+        if (!globals.exists()) {
+            legacy_globals_singleton legacy(get_self(), get_self().value);
+            check(legacy.exists(), "Contract not initialized - call init() first");
+            g = migrate_globals(legacy);
+            m.step = MIGRATE_RESPECT;
+            budget -= 1;
+        } else {
+            g = globals.get();
+            check(g.schema_version < SCHEMA_VERSION, "Schema is already current");
+            m = migration.get_or_default();
+        }
+
+        while (budget > 0 && m.step < MIGRATE_DONE) {
+            bool step_done = false;
+            switch (m.step) {
+                case MIGRATE_RESPECT:      step_done = migrate_respect(budget); break;
+                case MIGRATE_STAKES:       step_done = migrate_stakes(g, budget); break;
+                case MIGRATE_ANCHORS:      step_done = migrate_anchors(g, budget); break;
+                case MIGRATE_ATTESTATIONS: step_done = migrate_attestations(budget); break;
+                case MIGRATE_VOTES:        step_done = migrate_votes(budget); break;
+                case MIGRATE_LIKES:        step_done = migrate_likes(budget); break;
+            }
+            if (!step_done) break;
+            m.step += 1;
+        }
+
+        if (m.step < MIGRATE_DONE) {
+            PERF_ADD(rows_written, 1);
+            migration.set(m, get_self());
+        } else {
+            g.schema_version = SCHEMA_VERSION;
+            if (migration.exists()) {
+                PERF_ADD(rows_written, 1);
+                migration.remove();
+            }
+        }
+
+        PERF_ADD(rows_written, 1);
+        globals.set(g, get_self());
+        return m.step < MIGRATE_DONE ? m.step : 0;
+    }
+
     /**
      * @brief Notification action for off-chain indexers
      *
      * This action is called inline to emit events that indexers can monitor.
      * It performs no state changes and exists solely for event logging.
+     * Like every notification action it requires the contract's own
+     * authority, so indexers can trust the trace without reading tables.
      *
      * @param author - Account that created the anchor
      * @param type - Event type code
      * @param hash - SHA256 hash of the event
-     * @param anchor_id - Auto-incrementing anchor ID
+     * @param anchor_id - Hash-derived anchor ID
      * @param submission_number - Global submission counter (x)
+     * @param event_cid - IPFS CIDv1 of the full event JSON
+     * @param parent - Optional parent event hash
+     * @param ts - Original event timestamp
+     * @param tags - Searchable tags
+     * @param expires_at - When voting closes
+     * @param escrowed_amount - Tokens minted into escrow for the anchor
      */
     [[eosio::action]]
     void anchorevent(name author, uint8_t type, checksum256 hash,
-                     uint64_t anchor_id, uint64_t submission_number) {
-        // This is a notification action - no authorization required
+                     uint64_t anchor_id, uint64_t submission_number,
+                     std::string event_cid, std::optional<checksum256> parent, uint32_t ts,
+                     std::vector<name> tags, uint32_t expires_at, uint64_t escrowed_amount) {
         // Indexers listen to this action to track new anchors
         // No state changes occur here
+        require_auth(get_self());
+    }
+
+    /**
+     * @brief Notification action for anchors created by putbatch()
+     *
+     * Batch counterpart of anchorevent: one notification carries the
+     * summary of every anchor stored by a single putbatch() call.
+     *
+     * @param author - Account that created the anchors
+     * @param anchors - Type, hash, anchor ID, submission number, expiry and escrow of each anchor
+     */
+    [[eosio::action]]
+    void anchorbatch(name author, std::vector<anchor_summary> anchors) {
+        // Notification only - no state changes
+        require_auth(get_self());
+    }
+
+    /**
+     * @brief Notification action for anchors erased by prune()
+     *
+     * @param hashes - Event hashes whose on-chain rows were removed
+     */
+    [[eosio::action]]
+    void pruneevent(std::vector<checksum256> hashes) {
+        // Notification only - no state changes
+        require_auth(get_self());
+    }
+
+    /**
+     * @brief Notification action for votes applied by vote() and votebatch()
+     *
+     * @param voter - Account that voted
+     * @param votes - Anchor, value and Respect weight of each applied vote
+     */
+    [[eosio::action]]
+    void voteevent(name voter, std::vector<vote_summary> votes) {
+        // Notification only - no state changes
+        require_auth(get_self());
+    }
+
+    /**
+     * @brief Notification action for anchors settled by finalize() and crank()
+     *
+     * @param settled - Outcome and payout split of each settled anchor
+     */
+    [[eosio::action]]
+    void finalevent(std::vector<settlement_summary> settled) {
+        // Notification only - no state changes
+        require_auth(get_self());
+    }
+
+    /**
+     * @brief Notification action for stake() and unstake()
+     *
+     * @param account - Staker account
+     * @param node_id - Node staked on
+     * @param delta - Amount staked (positive) or unstaked (negative)
+     * @param position - Account's stake on the node afterwards
+     * @param node_total - Node's total stake afterwards
+     * @param staker_count - Node's staker count afterwards
+     */
+    [[eosio::action]]
+    void stakeevent(name account, checksum256 node_id, asset delta, asset position,
+                    asset node_total, uint32_t staker_count) {
+        // Notification only - no state changes
+        require_auth(get_self());
+    }
+
+    /**
+     * @brief Notification action for like() and unlike()
+     *
+     * @param account - Account liking or unliking
+     * @param node_id - Node liked
+     * @param liked - true for like(), false for unlike()
+     * @param path_hash - Discovery path digest (zero on unlike)
+     * @param path_length - Discovery path length (zero on unlike)
+     * @param like_count - Node's like count afterwards
+     */
+    [[eosio::action]]
+    void likeevent(name account, checksum256 node_id, bool liked, checksum256 path_hash,
+                   uint8_t path_length, uint32_t like_count) {
+        // Notification only - no state changes
+        require_auth(get_self());
+    }
+
+    /**
+     * @brief Notification action for Respect changes
+     *
+     * Lists only the accounts whose value changed. Staged changes (from
+     * respchunk) take effect when respcommit is applied for the round.
+     *
+     * @param election_round - Round the values belong to
+     * @param staged - true if emitted by respchunk, false by updrespect
+     * @param changes - Account:respect pairs that changed
+     */
+    [[eosio::action]]
+    void respevent(uint64_t election_round, bool staged, std::vector<std::pair<name, uint32_t>> changes) {
+        // Notification only - no state changes
+        require_auth(get_self());
+    }
+
+    /**
+     * @brief Notification action for a completed respabort()
+     *
+     * Every change staged for the round (respevent with staged=true) was
+     * discarded and will never take effect.
+     *
+     * @param election_round - Round whose staged epoch was aborted
+     */
+    [[eosio::action]]
+    void abortevent(uint64_t election_round) {
+        // Notification only - no state changes
+        require_auth(get_self());
     }
 
     /**
@@ -1191,7 +2521,9 @@ public:
         require_auth(get_self());
 
         // SAFETY CHECK 1: Prevent clearing production data
-        // Production systems will have >100 anchors, so this prevents accidents
+        // Production systems will have >100 anchors, so this prevents accidents.
+        // Counted from the rows themselves so it holds even if the globals
+        // counters were never seeded.
         anchors_table anchors(get_self(), get_self().value);
         uint64_t anchor_count = std::distance(anchors.begin(), anchors.end());
         check(anchor_count <= 100, "Cannot clear: too many anchors (production data detected)");
@@ -1203,7 +2535,15 @@ public:
         for(auto itr = nodeagg.begin(); itr != nodeagg.end(); ++itr) {
             total_staked += itr->total.amount;
         }
-        check(total_staked == 0, "Cannot clear: tokens are staked (would destroy value)");
+        globals_singleton globals(get_self(), get_self().value);
+        auto g = globals.get_or_default();
+        check(total_staked == 0 && g.total_staked == 0, "Cannot clear: tokens are staked (would destroy value)");
+
+        // Credited rewards are user funds too
+        balances_table balances(get_self(), get_self().value);
+        for(auto itr = balances.begin(); itr != balances.end(); ++itr) {
+            check(itr->balance.amount == 0, "Cannot clear: unwithdrawn balances exist (would destroy value)");
+        }
 
         // Clear all tables (reuse anchors table from safety check)
         auto anchors_itr = anchors.begin();
@@ -1211,10 +2551,26 @@ public:
             anchors_itr = anchors.erase(anchors_itr);
         }
 
-        votes_table votes(get_self(), get_self().value);
-        auto votes_itr = votes.begin();
-        while(votes_itr != votes.end()) {
-            votes_itr = votes.erase(votes_itr);
+        // Votes, attestations and thread rows are scoped by anchor ID, so clear each anchor's scopes first
+        anchorstate_table states(get_self(), get_self().value);
+        auto states_itr = states.begin();
+        while(states_itr != states.end()) {
+            votes_table votes(get_self(), states_itr->anchor_id);
+            auto votes_itr = votes.begin();
+            while(votes_itr != votes.end()) {
+                votes_itr = votes.erase(votes_itr);
+            }
+            attestations_table attestations(get_self(), states_itr->anchor_id);
+            auto att_itr = attestations.begin();
+            while(att_itr != attestations.end()) {
+                att_itr = attestations.erase(att_itr);
+            }
+            children_table children(get_self(), states_itr->anchor_id);
+            auto child_itr = children.begin();
+            while(child_itr != children.end()) {
+                child_itr = children.erase(child_itr);
+            }
+            states_itr = states.erase(states_itr);
         }
 
         respect_table respect(get_self(), get_self().value);
@@ -1223,47 +2579,291 @@ public:
             respect_itr = respect.erase(respect_itr);
         }
 
-        attestations_table attestations(get_self(), get_self().value);
-        auto att_itr = attestations.begin();
-        while(att_itr != attestations.end()) {
-            att_itr = attestations.erase(att_itr);
-        }
-
         likeagg_table likeagg(get_self(), get_self().value);
         auto likeagg_itr = likeagg.begin();
         while(likeagg_itr != likeagg.end()) {
             likeagg_itr = likeagg.erase(likeagg_itr);
         }
 
-        nodeagg_table nodeagg(get_self(), get_self().value);
         auto nodeagg_itr = nodeagg.begin();
         while(nodeagg_itr != nodeagg.end()) {
             nodeagg_itr = nodeagg.erase(nodeagg_itr);
         }
 
-        // Note: likes and stakes tables are scoped by account and cannot be
+        // Zero balances kept only for their claimall() cursor
+        auto balances_itr = balances.begin();
+        while(balances_itr != balances.end()) {
+            balances_itr = balances.erase(balances_itr);
+        }
+
+        hash_overflow_table overflow(get_self(), get_self().value);
+        auto overflow_itr = overflow.begin();
+        while(overflow_itr != overflow.end()) {
+            overflow_itr = overflow.erase(overflow_itr);
+        }
+
+        prunedhash_table pruned(get_self(), get_self().value);
+        auto pruned_itr = pruned.begin();
+        while(pruned_itr != pruned.end()) {
+            pruned_itr = pruned.erase(pruned_itr);
+        }
+
+        // Note: likes and stakes tables are scoped by account (tagindex by tag) and cannot be
         // cleared from contract scope. These would need to be cleared per-account
         // or through a separate cleanup mechanism if needed.
 
-        // Reset globals
-        globals_singleton globals(get_self(), get_self().value);
+        // Reset globals and any migration in progress
+        migration_singleton migration(get_self(), get_self().value);
+        migration.remove();
+        abort_singleton aborting(get_self(), get_self().value);
+        aborting.remove();
         globals.remove();
     }
-#endif // TESTNET
-
-private:
-    // ============ CONSTANTS ============
 
-    // Event type validation ranges
-    static constexpr uint8_t MIN_EVENT_TYPE = 1;
-    static constexpr uint8_t MAX_EVENT_TYPE = 99;
-    static constexpr uint8_t MIN_CONTENT_TYPE = 20;
-    static constexpr uint8_t MAX_CONTENT_TYPE = 39;
+    /**
+     * @brief Move an anchor's voting close into the past (TESTNET ONLY)
+     *
+     * Lets tests reach finalize() and prune() without waiting out the
+     * voting window and the retention period.
+     *
+     * @param tx_hash - Event hash of the anchor
+     * @param secs_ago - Seconds before now the voting window closes
+     */
+    ACTION backdate(checksum256 tx_hash, uint32_t secs_ago) {
+        require_auth(get_self());
 
-    // Timestamp validation (2023-01-01 00:00:00 UTC)
-    static constexpr uint32_t MIN_VALID_TIMESTAMP = 1672531200;
+        anchorstate_table states(get_self(), get_self().value);
+        auto anchor_itr = find_anchor_state(states, tx_hash);
+        check(anchor_itr != states.end(), "Anchor not found");
 
-    // ============ DATA STRUCTURES ============
+        uint32_t now = current_time_point().sec_since_epoch();
+        check(secs_ago <= now, "secs_ago out of range");
+        states.modify(anchor_itr, same_payer, [&](auto& st) {
+            st.expires_at = now - secs_ago;
+        });
+    }
+
+    /**
+     * @brief Turn a freshly initialized contract into schema 1 state (TESTNET ONLY)
+     *
+     * Moves globals2 back to the schema 1 globals row and writes a schema 1
+     * anchor, tally and up vote by voter for each hash, plus a Respect row
+     * for voter, so tests can drive migrate() over real legacy rows. Even
+     * positions stay open for an hour with 1000 * (i + 1) escrowed; odd
+     * positions are finalized.
+     *
+     * @param author - Author of the seeded anchors
+     * @param voter - Account voting on every seeded anchor (10 Respect)
+     * @param hashes - Event hashes, in anchor ID order
+     */
+    ACTION seedlegacy(name author, name voter, std::vector<checksum256> hashes) {
+        require_auth(get_self());
+
+        anchorstate_table states(get_self(), get_self().value);
+        check(states.begin() == states.end(), "Seeding requires a contract without anchors (clear, then init)");
+        auto g = get_globals();
+
+        legacy_global_state old;
+        old.x = g.x;
+        old.carry = 0.0;
+        old.round = g.round;
+        old.fractally_oracle = g.fractally_oracle;
+        old.token_contract = g.token_contract;
+        old.token_symbol = g.token_symbol;
+        old.council_account = g.council_account;
+        old.approval_threshold_bp = g.approval_threshold_bp;
+        old.max_vote_weight = g.max_vote_weight;
+        old.attestor_respect_threshold = g.attestor_respect_threshold;
+        old.paused = g.paused;
+        old.vote_window_release = g.vote_window_release;
+        old.vote_window_mint = g.vote_window_mint;
+        old.vote_window_resolve = g.vote_window_resolve;
+        old.vote_window_claim = g.vote_window_claim;
+        old.vote_window_merge = g.vote_window_merge;
+        old.vote_window_default = g.vote_window_default;
+        old.multiplier_release = g.multiplier_release;
+        old.multiplier_mint = g.multiplier_mint;
+        old.multiplier_resolve = g.multiplier_resolve;
+        old.multiplier_add_claim = g.multiplier_add_claim;
+        old.multiplier_edit_claim = g.multiplier_edit_claim;
+        old.multiplier_merge = g.multiplier_merge;
+        old.approved_author_pct = g.approved_author_pct;
+        old.approved_voters_pct = g.approved_voters_pct;
+        old.approved_stakers_pct = g.approved_stakers_pct;
+        old.rejected_voters_pct = g.rejected_voters_pct;
+        old.rejected_stakers_pct = g.rejected_stakers_pct;
+
+        legacy_globals_singleton legacy_globals(get_self(), get_self().value);
+        legacy_globals.set(old, get_self());
+        globals_singleton globals(get_self(), get_self().value);
+        globals.remove();
+        migration_singleton migration(get_self(), get_self().value);
+        migration.remove();
+
+        uint32_t now = current_time_point().sec_since_epoch();
+        legacy_anchors_table anchors(get_self(), get_self().value);
+        legacy_votetally_table tallies(get_self(), get_self().value);
+        legacy_votes_table votes(get_self(), get_self().value);
+        for (uint64_t i = 0; i < hashes.size(); ++i) {
+            bool finalized = (i % 2 == 1);
+            anchors.emplace(get_self(), [&](auto& a) {
+                a.id = i;
+                a.author = author;
+                a.type = 21;
+                a.hash = hashes[i];
+                a.event_cid = "bafkreilegacy";
+                a.ts = now;
+                a.expires_at = finalized ? now - 1 : now + 3600;
+                a.finalized = finalized;
+                a.escrowed_amount = finalized ? 0 : 1000 * (i + 1);
+                a.submission_x = i + 1;
+            });
+            tallies.emplace(get_self(), [&](auto& t) {
+                t.anchor_id = i;
+                t.tx_hash = hashes[i];
+                t.up_weight = 1;
+                t.up_voter_count = 1;
+                t.updated_at = current_time_point();
+            });
+            votes.emplace(get_self(), [&](auto& v) {
+                v.id = i;
+                v.tx_hash = hashes[i];
+                v.voter = voter;
+                v.val = 1;
+                v.weight = 1;
+                v.ts = current_time_point();
+            });
+        }
+
+        legacy_respect_table respect(get_self(), get_self().value);
+        respect.emplace(get_self(), [&](auto& r) {
+            r.account = voter;
+            r.respect = 10;
+            r.round = g.round;
+            r.updated_at = current_time_point();
+        });
+    }
+#endif // TESTNET
+
+#ifdef PERF_STATS
+    /**
+     * @brief Accumulated counters per action (PERF_STATS builds only)
+     */
+    TABLE perf_row {
+        name        action;             // Instrumented action (primary key)
+        uint64_t    calls = 0;
+        uint64_t    rows_read = 0;
+        uint64_t    rows_written = 0;
+        uint64_t    inline_actions = 0;
+        uint64_t    voters_iterated = 0;
+        uint64_t    stakers_iterated = 0;
+        uint64_t    ram_bytes = 0;
+
+        uint64_t primary_key() const { return action.value; }
+
+        EOSLIB_SERIALIZE(perf_row, (action)(calls)(rows_read)(rows_written)
+                        (inline_actions)(voters_iterated)(stakers_iterated)(ram_bytes))
+    };
+
+    /**
+     * @brief Return the accumulated per-action counters (PERF_STATS builds only)
+     *
+     * Read-only: one row per instrumented action, with the call count and
+     * the totals of every counter in perf_counters. Divide by calls for
+     * the per-call average.
+     */
+    [[eosio::action, eosio::read_only]]
+    std::vector<perf_row> getperf() {
+        perfstats_table perfstats(get_self(), get_self().value);
+        std::vector<perf_row> rows;
+        for (const auto& row : perfstats) {
+            rows.push_back(row);
+        }
+        return rows;
+    }
+
+    /**
+     * @brief Erase all perfstats rows (PERF_STATS builds only)
+     *
+     * Used between benchmark runs so each run starts from zero.
+     *
+     * @pre Requires contract authority
+     */
+    ACTION resetperf() {
+        require_auth(get_self());
+
+        perfstats_table perfstats(get_self(), get_self().value);
+        auto itr = perfstats.begin();
+        while (itr != perfstats.end()) {
+            itr = perfstats.erase(itr);
+        }
+    }
+#endif // PERF_STATS
+
+private:
+    // ============ CONSTANTS ============
+
+    // Event type codes and their policies live in polaris.core.hpp (policy_of)
+
+    // Timestamp validation (2023-01-01 00:00:00 UTC)
+    static constexpr uint32_t MIN_VALID_TIMESTAMP = 1672531200;
+
+    // Slots probed after a hash-derived primary key (see find_by_hash_key)
+    static constexpr uint64_t HASH_PROBE_WINDOW = polaris_core::HASH_PROBE_WINDOW;
+
+    // Keys at or above this live in hashoverflow (see probe_hash_key)
+    static constexpr uint64_t OVERFLOW_KEY_BASE = polaris_core::OVERFLOW_KEY_BASE;
+
+    // Maximum anchors accepted by a single putbatch()
+    static constexpr size_t MAX_PUT_BATCH = 50;
+
+    // Maximum votes accepted by a single votebatch()
+    static constexpr size_t MAX_VOTE_BATCH = 100;
+
+    // Vote outcome codes (apply_vote, votebatch return value)
+    static constexpr uint8_t VOTE_APPLIED = 0;
+    static constexpr uint8_t VOTE_INVALID_VALUE = 1;
+    static constexpr uint8_t VOTE_ANCHOR_NOT_FOUND = 2;
+    static constexpr uint8_t VOTE_FINALIZED = 3;
+    static constexpr uint8_t VOTE_WINDOW_CLOSED = 4;
+    static constexpr uint8_t VOTE_NOT_VOTABLE = 5;
+
+    // Maximum anchors settled by a single crank()
+    static constexpr uint32_t MAX_CRANK_ITEMS = 50;
+
+    // Maximum rows erased by a single prune()
+    static constexpr uint32_t MAX_PRUNE_ROWS = 500;
+
+    // Maximum rows returned by a single read-only query page
+    static constexpr uint32_t MAX_QUERY_ROWS = 100;
+
+    // Maximum pendingrwd and stake rows visited by a single claimall()
+    static constexpr uint32_t MAX_CLAIM_ROWS = 100;
+
+    // Table layout written by this build (see migrate)
+    static constexpr uint32_t SCHEMA_VERSION = 2;
+    // Layout before migrate() existed (see SCHEMA 1 LAYOUTS)
+    static constexpr uint32_t LEGACY_SCHEMA_VERSION = 1;
+
+    // Maximum source rows visited by a single migrate()
+    static constexpr uint32_t MAX_MIGRATE_ROWS = 500;
+
+    // Maximum respect rows visited by a single respabort()
+    static constexpr uint32_t MAX_RESPABORT_ROWS = 500;
+
+    // migrate() steps, run in this order
+    static constexpr uint8_t MIGRATE_GLOBALS = 1;
+    static constexpr uint8_t MIGRATE_RESPECT = 2;
+    static constexpr uint8_t MIGRATE_STAKES = 3;
+    static constexpr uint8_t MIGRATE_ANCHORS = 4;
+    static constexpr uint8_t MIGRATE_ATTESTATIONS = 5;
+    static constexpr uint8_t MIGRATE_VOTES = 6;
+    static constexpr uint8_t MIGRATE_LIKES = 7;
+    static constexpr uint8_t MIGRATE_DONE = 8;
+
+    // Fixed-point emission and reward accumulator constants live in polaris.core.hpp
+
+    // ============ DATA STRUCTURES ============
 
     /**
      * @brief Anchored events table
@@ -1272,7 +2872,8 @@ private:
      * retrieved from off-chain storage using the hash.
      */
     TABLE anchor {
-        uint64_t    id;              // Auto-incrementing primary key
+        uint64_t    id;              // Hash-derived key (see find_by_hash_key)
+        uint64_t    seq;             // Submission order (g.anchor_count at put time)
         name        author;          // Account that submitted
         uint8_t     type;           // Event type code
         checksum256 hash;           // SHA256 of canonical event
@@ -1280,38 +2881,98 @@ private:
         std::optional<checksum256> parent; // Parent for threading
         uint32_t    ts;             // Original timestamp
         std::vector<name> tags;     // Searchable tags
-        uint32_t    expires_at;     // When voting closes
-        bool        finalized;      // Rewards distributed?
-        uint64_t    escrowed_amount = 0; // Tokens minted and held in escrow
-        uint64_t    submission_x = 0;    // Value of g.x at submission time
 
         uint64_t primary_key() const { return id; }
-        checksum256 by_hash() const { return hash; }
         uint64_t by_author() const { return author.value; }
+        uint64_t by_seq() const { return seq; }
 
-        EOSLIB_SERIALIZE(anchor, (id)(author)(type)(hash)(event_cid)(parent)
-                                 (ts)(tags)(expires_at)(finalized)
-                                 (escrowed_amount)(submission_x))
+        EOSLIB_SERIALIZE(anchor, (id)(seq)(author)(type)(hash)(event_cid)(parent)
+                                 (ts)(tags))
+    };
+
+    /**
+     * @brief Settlement state of an anchor (hot, fixed-size)
+     *
+     * Split from the anchor metadata row so attest, vote, finalize and
+     * claimvote only deserialize the small fields they need. Writers:
+     * put() emplaces it and bumps the parent's child_count/last_child_at
+     * (store_anchor); finalize() and crank set finalized and zero the escrow
+     * (settle_anchor); attest() bumps attestation_count; prune() unlinks
+     * a child from its parent (unlink_child) and erases the row; migrate()
+     * rebuilds it from the schema 1 anchors row and replays attestations.
+     * The metadata row is never touched after put().
+     */
+    TABLE anchor_state {
+        uint64_t    anchor_id;       // Same ID as the anchors row
+        checksum256 hash;            // SHA256 of canonical event
+        name        author;          // Account that submitted
+        uint8_t     type;            // Event type code
+        uint32_t    expires_at;      // When voting closes
+        bool        finalized;       // Rewards distributed?
+        uint64_t    escrowed_amount = 0; // Tokens minted and held in escrow
+        uint64_t    submission_x = 0;    // Value of g.x at submission time
+        uint32_t    attestation_count = 0; // Distinct attestors (see attest)
+        uint32_t    child_count = 0;       // Replies indexed in this anchor's children scope
+        uint32_t    last_child_at = 0;     // When the latest reply was anchored
+
+        uint64_t primary_key() const { return anchor_id; }
+        // Unfinalized anchors first, oldest expiry first (see crank)
+        uint128_t by_expiry() const {
+            return (uint128_t(finalized ? 1 : 0) << 64) | uint128_t(expires_at);
+        }
+
+        EOSLIB_SERIALIZE(anchor_state, (anchor_id)(hash)(author)(type)(expires_at)
+                                       (finalized)(escrowed_amount)(submission_x)(attestation_count)
+                                       (child_count)(last_child_at))
+    };
+
+    /**
+     * @brief Tag index (scoped by tag name)
+     *
+     * One row per tag of an anchor, keyed by the anchor's seq so a tag's
+     * scope lists its anchors in submission order. Written by put(),
+     * erased with the anchor by prune().
+     */
+    TABLE tag_entry {
+        uint64_t    seq;             // Submission order of the anchor (anchors.seq)
+        uint64_t    anchor_id;       // Anchor carrying the tag
+
+        uint64_t primary_key() const { return seq; }
+
+        EOSLIB_SERIALIZE(tag_entry, (seq)(anchor_id))
+    };
+
+    /**
+     * @brief Thread index (scoped by parent anchor ID)
+     *
+     * One row per reply, keyed by the reply's seq so a parent's scope lists
+     * its thread in submission order. Written by put() together with the
+     * parent's child_count and last_child_at, erased by prune().
+     */
+    TABLE child_entry {
+        uint64_t    seq;             // Submission order of the reply (anchors.seq)
+        uint64_t    anchor_id;       // Reply anchor
+
+        uint64_t primary_key() const { return seq; }
+
+        EOSLIB_SERIALIZE(child_entry, (seq)(anchor_id))
     };
 
     /**
      * @brief Vote records with Respect weights
+     *
+     * Scoped by anchor ID with the voter as primary key, so each anchor's
+     * votes live in their own scope and a vote lookup is a primary find.
      */
     TABLE vote_record {
-        uint64_t    id;             // Primary key
-        checksum256 tx_hash;        // Event being voted on
-        name        voter;          // Who voted
+        name        voter;          // Who voted (primary key)
         int8_t      val;           // Vote: +1, 0, -1
         uint32_t    weight;        // Respect weight at vote time
         time_point  ts;            // When voted
 
-        uint64_t primary_key() const { return id; }
-        uint128_t by_voter_hash() const {
-            return combine_keys(voter.value, tx_hash);
-        }
-        checksum256 by_hash() const { return tx_hash; }
+        uint64_t primary_key() const { return voter.value; }
 
-        EOSLIB_SERIALIZE(vote_record, (id)(tx_hash)(voter)(val)(weight)(ts))
+        EOSLIB_SERIALIZE(vote_record, (voter)(val)(weight)(ts))
     };
 
     /**
@@ -1320,28 +2981,37 @@ private:
     TABLE respect_record {
         name        account;        // Account with Respect
         uint32_t    respect;       // Current Respect value
-        uint64_t    round;         // Election round number
+        uint64_t    round;         // Election round of the current value
         time_point  updated_at;    // Last update time
+        uint32_t    staged_respect = 0; // Value pushed by respchunk (see effective_respect)
+        uint64_t    staged_round = 0;   // Round of staged_respect (0 = nothing staged)
 
         uint64_t primary_key() const { return account.value; }
 
-        EOSLIB_SERIALIZE(respect_record, (account)(respect)(round)(updated_at))
+        EOSLIB_SERIALIZE(respect_record, (account)(respect)(round)(updated_at)
+                                         (staged_respect)(staged_round))
     };
 
     /**
-     * @brief Individual stake records (scoped by account)
+     * @brief Stake positions (scoped by account)
+     *
+     * The one authoritative record of an account's stake on a node. Besides
+     * the amount it holds the value of the global reward accumulator at the
+     * position's last settlement: accrued rewards are
+     * amount * (reward_per_stake - reward_snapshot). Iterating the scope is
+     * the account's portfolio; per-node totals live in nodeagg.
      */
     TABLE stake_record {
-        uint64_t    id;             // Primary key (surrogate)
+        uint64_t    id;             // Node-derived key (see find_by_hash_key)
         checksum256 node_id;        // What's being staked on
         asset       amount;         // Amount staked
         time_point  staked_at;      // When first staked
         time_point  last_updated;   // Last change
+        uint128_t   reward_snapshot = 0; // g.reward_per_stake at last settlement
 
         uint64_t primary_key() const { return id; }
-        checksum256 by_node() const { return node_id; }
 
-        EOSLIB_SERIALIZE(stake_record, (id)(node_id)(amount)(staked_at)(last_updated))
+        EOSLIB_SERIALIZE(stake_record, (id)(node_id)(amount)(staked_at)(last_updated)(reward_snapshot))
     };
 
 
@@ -1349,69 +3019,60 @@ private:
      * @brief Aggregated stakes by node
      */
     TABLE node_aggregate {
-        uint64_t    id;             // Primary key (surrogate)
+        uint64_t    id;             // Node-derived key (see find_by_hash_key)
         checksum256 node_id;        // Node identifier
         asset       total;          // Total staked
         uint32_t    staker_count;   // Number of stakers
 
         uint64_t primary_key() const { return id; }
-        checksum256 by_node() const { return node_id; }
 
         EOSLIB_SERIALIZE(node_aggregate, (id)(node_id)(total)(staker_count))
     };
 
 
     /**
-     * @brief Staker tracking for reward distribution
+     * @brief Attestation records for high-value submissions
      *
-     * Tracks which accounts have stakes on which nodes.
-     * This enables iterating all stakers for a node when distributing rewards.
+     * Scoped by anchor ID with the attestor as primary key, like votes, so
+     * a repeated attestation is a primary find. The confirmed type is
+     * checked against the anchor and not stored.
      */
-    TABLE staker_node {
-        uint64_t    id;             // Primary key
-        name        account;        // Staker account
-        checksum256 node_id;        // Node being staked on
-        asset       amount;         // Current stake amount (cached for quick access)
+    TABLE attestation {
+        name        attestor;       // Who attested (primary key)
+        time_point  ts;             // When attested
 
-        uint64_t primary_key() const { return id; }
-        checksum256 by_node() const { return node_id; }
-        uint64_t by_account() const { return account.value; }
-        uint128_t by_account_node() const {
-            return combine_keys(account.value, node_id);
-        }
+        uint64_t primary_key() const { return attestor.value; }
 
-        EOSLIB_SERIALIZE(staker_node, (id)(account)(node_id)(amount))
+        EOSLIB_SERIALIZE(attestation, (attestor)(ts))
     };
 
     /**
-     * @brief Attestation records for high-value submissions
+     * @brief Credited reward balances awaiting withdraw()
      */
-    TABLE attestation {
-        uint64_t    id;
-        checksum256 tx_hash;        // Event attested
-        name        attestor;       // Who attested
-        uint8_t     type;          // Event type confirmed
-        time_point  ts;            // When attested
+    TABLE balance_record {
+        name        account;        // Balance owner (primary key)
+        asset       balance;        // Credited, not yet withdrawn
+        time_point  last_updated;   // Last credit
+        uint64_t    claim_cursor = 0; // stakes key where the next claimall() resumes (0 = start)
 
-        uint64_t primary_key() const { return id; }
-        checksum256 by_hash() const { return tx_hash; }
+        uint64_t primary_key() const { return account.value; }
 
-        EOSLIB_SERIALIZE(attestation, (id)(tx_hash)(attestor)(type)(ts))
+        EOSLIB_SERIALIZE(balance_record, (account)(balance)(last_updated)(claim_cursor))
     };
 
     /**
      * @brief Like records (scoped by account)
      */
     TABLE like_record {
-        uint64_t    id;                 // Primary key (surrogate)
+        uint64_t    id;                 // Node-derived key (see find_by_hash_key)
         checksum256 node_id;            // Liked entity
-        std::vector<checksum256> path;  // Discovery path
+        checksum256 path_hash;          // sha256 of the packed discovery path
+        uint8_t     path_length;        // Nodes in the discovery path
         time_point  liked_at;           // When liked
 
         uint64_t primary_key() const { return id; }
-        checksum256 by_node() const { return node_id; }
 
-        EOSLIB_SERIALIZE(like_record, (id)(node_id)(path)(liked_at))
+        EOSLIB_SERIALIZE(like_record, (id)(node_id)(path_hash)(path_length)(liked_at))
     };
 
 
@@ -1419,12 +3080,11 @@ private:
      * @brief Aggregated likes by node
      */
     TABLE like_aggregate {
-        uint64_t    id;             // Primary key (surrogate)
+        uint64_t    id;             // Node-derived key (see find_by_hash_key)
         checksum256 node_id;        // Node identifier
         uint32_t    like_count;     // Number of likes
 
         uint64_t primary_key() const { return id; }
-        checksum256 by_node() const { return node_id; }
 
         EOSLIB_SERIALIZE(like_aggregate, (id)(node_id)(like_count))
     };
@@ -1437,47 +3097,83 @@ private:
      */
     TABLE vote_tally {
         uint64_t    anchor_id;         // Primary key (matches anchor.id)
-        checksum256 tx_hash;           // Anchor event hash (for lookup)
+        checksum256 tx_hash;           // Anchor event hash
         uint64_t    up_weight = 0;     // Sum of upvote weights
         uint64_t    down_weight = 0;   // Sum of downvote weights
         uint32_t    up_voter_count = 0;   // Number of upvoters
         uint32_t    down_voter_count = 0; // Number of downvoters
         time_point  updated_at;        // Last tally update
+        int8_t      rewarded_side = 0; // Set by finalize: +1 YES voters, -1 NO voters, 0 none
+        uint64_t    voter_share = 0;   // Set by finalize: amount each rewarded voter can claim
 
         uint64_t primary_key() const { return anchor_id; }
-        checksum256 by_hash() const { return tx_hash; }
 
         EOSLIB_SERIALIZE(vote_tally, (anchor_id)(tx_hash)(up_weight)(down_weight)
-                                     (up_voter_count)(down_voter_count)(updated_at))
+                                     (up_voter_count)(down_voter_count)(updated_at)
+                                     (rewarded_side)(voter_share))
     };
 
 
     /**
      * @brief Pending staker rewards (scoped by account)
      *
-     * Tracks unclaimed rewards from rejected submissions.
-     * Stakers call claimreward() to collect their share.
+     * Holds rewards already settled out of the accumulator (on stake/unstake).
+     * Balances recorded by the pre-accumulator distribution stay in the
+     * schema 1 pendingrwd table. Stakers call claimreward() to collect both.
      */
     TABLE pending_reward {
-        uint64_t    id;             // Primary key (surrogate)
+        uint64_t    id;             // Node-derived key (see find_by_hash_key)
         checksum256 node_id;        // Node where stake earned rewards
         asset       amount;         // Unclaimed reward amount
         time_point  earned_at;      // When reward was earned
         time_point  last_updated;   // Last time reward was added
 
         uint64_t primary_key() const { return id; }
-        checksum256 by_node() const { return node_id; }
 
         EOSLIB_SERIALIZE(pending_reward, (id)(node_id)(amount)(earned_at)(last_updated))
     };
 
+    /**
+     * @brief Hash-keyed row whose probe window was full (contract scope)
+     *
+     * Hashes are caller-supplied, so anyone can fill the few slots a hash
+     * maps to. The row then gets a key at or above OVERFLOW_KEY_BASE in its
+     * own table, and this entry finds it again by hash.
+     */
+    TABLE hash_overflow {
+        uint64_t    id;             // Surrogate key (available_primary_key)
+        uint64_t    key;            // Primary key of the row in its own table
+        checksum256 lookup;         // sha256 of (table, scope, hash), see overflow_lookup
+
+        uint64_t primary_key() const { return id; }
+        checksum256 by_lookup() const { return lookup; }
+
+        EOSLIB_SERIALIZE(hash_overflow, (id)(key)(lookup))
+    };
+
+    /**
+     * @brief Hash of a pruned anchor (contract scope)
+     *
+     * Left behind by prune() when it erases an anchor's settlement state,
+     * so put() keeps rejecting the hash once its rows are gone. Hash-keyed
+     * like anchorstate and billed to the contract.
+     */
+    TABLE pruned_hash {
+        uint64_t    id;             // Hash-derived key (see find_by_hash_key)
+        checksum256 hash;           // Event hash of the pruned anchor
+
+        uint64_t primary_key() const { return id; }
+
+        EOSLIB_SERIALIZE(pruned_hash, (id)(hash))
+    };
+
 
     /**
      * @brief Global state singleton
      */
     TABLE global_state {
         uint64_t    x;              // Global submission counter
-        double      carry;          // Fractional emission accumulator
+        double      carry;          // Legacy fractional accumulator (folded into carry_q32 by migrate, always 0)
         uint64_t    round;          // Current round
         name        fractally_oracle; // Who can update Respect
         name        token_contract; // Token contract (e.g. eosio.token compatible)
@@ -1515,6 +3211,27 @@ private:
         uint64_t    rejected_voters_pct = 5000;    // 50% to no-voters if rejected (equal distribution)
         uint64_t    rejected_stakers_pct = 5000;   // 50% to stakers if rejected
 
+        // Staker reward accumulator (see distribute_to_stakers)
+        uint128_t   reward_per_stake = 0;  // Cumulative reward per staked unit, scaled by polaris_core::REWARD_PRECISION
+        uint64_t    total_staked = 0;      // Sum of all active stake amounts
+
+        uint64_t    anchor_count = 0;      // Anchors ever stored (next anchors.seq)
+
+        uint64_t    staging_round = 0;     // Respect round being staged (0 = none, see respbegin)
+
+        uint64_t    carry_q32 = 0;         // Fractional emission accumulator (Q32.32, < 1 token unit after each mint)
+
+        // Settled anchors are prunable this long after their voting window closed
+        uint32_t    prune_retention = 7776000;  // 90 days
+
+        // Running totals (maintained by put/finalize, readable as health metrics)
+        uint64_t    open_anchors = 0;      // Anchors not yet finalized
+        uint64_t    open_escrow = 0;       // Escrow held for unfinalized anchors
+        uint64_t    settled_votes = 0;     // Voters counted on finalized anchors
+        uint64_t    unissued_escrow = 0;   // Escrow minted by put but not yet issued (see issueepoch)
+
+        uint32_t    schema_version = 0;    // Table layout version (SCHEMA_VERSION once migrate() completes)
+
         EOSLIB_SERIALIZE(global_state, (x)(carry)(round)(fractally_oracle)(token_contract)(token_symbol)(council_account)
                         (approval_threshold_bp)(max_vote_weight)(attestor_respect_threshold)
                         (paused)
@@ -1523,53 +3240,396 @@ private:
                         (multiplier_release)(multiplier_mint)(multiplier_resolve)
                         (multiplier_add_claim)(multiplier_edit_claim)(multiplier_merge)
                         (approved_author_pct)(approved_voters_pct)(approved_stakers_pct)
-                        (rejected_voters_pct)(rejected_stakers_pct))
+                        (rejected_voters_pct)(rejected_stakers_pct)
+                        (reward_per_stake)(total_staked)
+                        (anchor_count)(staging_round)(carry_q32)(prune_retention)
+                        (open_anchors)(open_escrow)(settled_votes)(unissued_escrow)
+                        (schema_version))
     };
 
-    // Table type definitions
-    typedef eosio::multi_index<"anchors"_n, anchor,
-        indexed_by<"byhash"_n, const_mem_fun<anchor, checksum256, &anchor::by_hash>>,
-        indexed_by<"byauthor"_n, const_mem_fun<anchor, uint64_t, &anchor::by_author>>
+    // Table type definitions. Tables whose layout changed since schema 1
+    // use a new name; the old name keeps the old rows (see SCHEMA 1 LAYOUTS).
+    typedef eosio::multi_index<"anchors2"_n, anchor,
+        indexed_by<"byauthor"_n, const_mem_fun<anchor, uint64_t, &anchor::by_author>>,
+        indexed_by<"byseq"_n, const_mem_fun<anchor, uint64_t, &anchor::by_seq>>
     > anchors_table;
 
-    typedef eosio::multi_index<"votes"_n, vote_record,
-        indexed_by<"byvoterhash"_n, const_mem_fun<vote_record, uint128_t, &vote_record::by_voter_hash>>,
-        indexed_by<"byhash"_n, const_mem_fun<vote_record, checksum256, &vote_record::by_hash>>
-    > votes_table;
-
-    typedef eosio::multi_index<"respect"_n, respect_record> respect_table;
-
-    typedef eosio::multi_index<"stakes"_n, stake_record,
-        indexed_by<"bynode"_n, const_mem_fun<stake_record, checksum256, &stake_record::by_node>>
-    > stakes_table;
-
-    typedef eosio::multi_index<"nodeagg"_n, node_aggregate,
-        indexed_by<"bynode"_n, const_mem_fun<node_aggregate, checksum256, &node_aggregate::by_node>>
-    > nodeagg_table;
-    typedef eosio::multi_index<"stakernodes"_n, staker_node,
-        indexed_by<"bynode"_n, const_mem_fun<staker_node, checksum256, &staker_node::by_node>>,
-        indexed_by<"byaccount"_n, const_mem_fun<staker_node, uint64_t, &staker_node::by_account>>,
-        indexed_by<"byaccnode"_n, const_mem_fun<staker_node, uint128_t, &staker_node::by_account_node>>
-    > staker_nodes_table;
-    typedef eosio::multi_index<"attestations"_n, attestation,
-        indexed_by<"byhash"_n, const_mem_fun<attestation, checksum256, &attestation::by_hash>>
-    > attestations_table;
-    typedef eosio::multi_index<"likes"_n, like_record,
-        indexed_by<"bynode"_n, const_mem_fun<like_record, checksum256, &like_record::by_node>>
-    > likes_table;
-
-    typedef eosio::multi_index<"likeagg"_n, like_aggregate,
-        indexed_by<"bynode"_n, const_mem_fun<like_aggregate, checksum256, &like_aggregate::by_node>>
-    > likeagg_table;
-
-    typedef eosio::multi_index<"votetally"_n, vote_tally,
-        indexed_by<"byhash"_n, const_mem_fun<vote_tally, checksum256, &vote_tally::by_hash>>
-    > votetally_table;
-
-    typedef eosio::multi_index<"pendingrwd"_n, pending_reward,
-        indexed_by<"bynode"_n, const_mem_fun<pending_reward, checksum256, &pending_reward::by_node>>
-    > pending_rewards_table;
-    typedef eosio::singleton<"globals"_n, global_state> globals_singleton;
+    typedef eosio::multi_index<"anchorstate"_n, anchor_state,
+        indexed_by<"byexpiry"_n, const_mem_fun<anchor_state, uint128_t, &anchor_state::by_expiry>>
+    > anchorstate_table;
+
+    typedef eosio::multi_index<"tagindex"_n, tag_entry> tagindex_table;
+
+    typedef eosio::multi_index<"children"_n, child_entry> children_table;
+
+    // New name: the former contract-scoped "votes" rows have a different layout
+    typedef eosio::multi_index<"votes2"_n, vote_record> votes_table;
+
+    typedef eosio::multi_index<"respect2"_n, respect_record> respect_table;
+
+    typedef eosio::multi_index<"stakes2"_n, stake_record> stakes_table;
+
+    typedef eosio::multi_index<"nodeagg2"_n, node_aggregate> nodeagg_table;
+
+    // Anchor-scoped; must not share a table with the former contract-scoped rows
+    typedef eosio::multi_index<"attestation2"_n, attestation> attestations_table;
+
+    typedef eosio::multi_index<"likes2"_n, like_record> likes_table;
+
+    typedef eosio::multi_index<"likeagg2"_n, like_aggregate> likeagg_table;
+
+    typedef eosio::multi_index<"votetally2"_n, vote_tally> votetally_table;
+
+    typedef eosio::multi_index<"pendingrwd2"_n, pending_reward> pending_rewards_table;
+
+    typedef eosio::multi_index<"hashoverflow"_n, hash_overflow,
+        indexed_by<"bylookup"_n, const_mem_fun<hash_overflow, checksum256, &hash_overflow::by_lookup>>
+    > hash_overflow_table;
+
+    typedef eosio::multi_index<"prunedhash"_n, pruned_hash> prunedhash_table;
+
+    typedef eosio::multi_index<"balances"_n, balance_record> balances_table;
+    typedef eosio::singleton<"globals2"_n, global_state> globals_singleton;
+
+    /**
+     * @brief Progress of a running migrate() (erased once it completes)
+     *
+     * Every step erases the schema 1 rows it has converted, so the next
+     * call resumes at the first row left and no cursor is needed.
+     */
+    TABLE migration_state {
+        uint8_t     step = MIGRATE_GLOBALS; // Step the next migrate() resumes at
+
+        EOSLIB_SERIALIZE(migration_state, (step))
+    };
+
+    typedef eosio::singleton<"migration"_n, migration_state> migration_singleton;
+
+    /**
+     * @brief Progress of a running respabort() (erased once it completes)
+     */
+    TABLE abort_state {
+        uint64_t    cursor = 0;     // Respect row (account value) the next respabort() resumes at
+
+        EOSLIB_SERIALIZE(abort_state, (cursor))
+    };
+
+    typedef eosio::singleton<"abortstate"_n, abort_state> abort_singleton;
+
+    // ============ SCHEMA 1 LAYOUTS ============
+    //
+    // Rows written before migrate() existed, under their original table
+    // names. Copied field for field from that build and declared as plain
+    // structs, so they stay out of the ABI. Every secondary index is kept,
+    // so erasing a row also removes its index entries.
+
+    struct legacy_anchor {
+        uint64_t    id;
+        name        author;
+        uint8_t     type;
+        checksum256 hash;
+        std::string event_cid;
+        std::optional<checksum256> parent;
+        uint32_t    ts;
+        std::vector<name> tags;
+        uint32_t    expires_at;
+        bool        finalized;
+        uint64_t    escrowed_amount = 0;
+        uint64_t    submission_x = 0;
+
+        uint64_t primary_key() const { return id; }
+        checksum256 by_hash() const { return hash; }
+        uint64_t by_author() const { return author.value; }
+
+        EOSLIB_SERIALIZE(legacy_anchor, (id)(author)(type)(hash)(event_cid)(parent)
+                                        (ts)(tags)(expires_at)(finalized)
+                                        (escrowed_amount)(submission_x))
+    };
+
+    struct legacy_vote {
+        uint64_t    id;
+        checksum256 tx_hash;
+        name        voter;
+        int8_t      val;
+        uint32_t    weight;
+        time_point  ts;
+
+        uint64_t primary_key() const { return id; }
+        uint128_t by_voter_hash() const { return combine_keys(voter.value, tx_hash); }
+        checksum256 by_hash() const { return tx_hash; }
+
+        EOSLIB_SERIALIZE(legacy_vote, (id)(tx_hash)(voter)(val)(weight)(ts))
+    };
+
+    struct legacy_respect {
+        name        account;
+        uint32_t    respect;
+        uint64_t    round;
+        time_point  updated_at;
+
+        uint64_t primary_key() const { return account.value; }
+
+        EOSLIB_SERIALIZE(legacy_respect, (account)(respect)(round)(updated_at))
+    };
+
+    struct legacy_stake {
+        uint64_t    id;
+        checksum256 node_id;
+        asset       amount;
+        time_point  staked_at;
+        time_point  last_updated;
+
+        uint64_t primary_key() const { return id; }
+        checksum256 by_node() const { return node_id; }
+
+        EOSLIB_SERIALIZE(legacy_stake, (id)(node_id)(amount)(staked_at)(last_updated))
+    };
+
+    struct legacy_node_aggregate {
+        uint64_t    id;
+        checksum256 node_id;
+        asset       total;
+        uint32_t    staker_count;
+
+        uint64_t primary_key() const { return id; }
+        checksum256 by_node() const { return node_id; }
+
+        EOSLIB_SERIALIZE(legacy_node_aggregate, (id)(node_id)(total)(staker_count))
+    };
+
+    struct legacy_staker_node {
+        uint64_t    id;
+        name        account;
+        checksum256 node_id;
+        asset       amount;
+
+        uint64_t primary_key() const { return id; }
+        checksum256 by_node() const { return node_id; }
+        uint64_t by_account() const { return account.value; }
+        uint128_t by_account_node() const { return combine_keys(account.value, node_id); }
+
+        EOSLIB_SERIALIZE(legacy_staker_node, (id)(account)(node_id)(amount))
+    };
+
+    struct legacy_attestation {
+        uint64_t    id;
+        checksum256 tx_hash;
+        name        attestor;
+        uint8_t     type;
+        time_point  ts;
+
+        uint64_t primary_key() const { return id; }
+        checksum256 by_hash() const { return tx_hash; }
+
+        EOSLIB_SERIALIZE(legacy_attestation, (id)(tx_hash)(attestor)(type)(ts))
+    };
+
+    struct legacy_like {
+        uint64_t    id;
+        checksum256 node_id;
+        std::vector<checksum256> path;
+        time_point  liked_at;
+
+        uint64_t primary_key() const { return id; }
+        checksum256 by_node() const { return node_id; }
+
+        EOSLIB_SERIALIZE(legacy_like, (id)(node_id)(path)(liked_at))
+    };
+
+    struct legacy_like_aggregate {
+        uint64_t    id;
+        checksum256 node_id;
+        uint32_t    like_count;
+
+        uint64_t primary_key() const { return id; }
+        checksum256 by_node() const { return node_id; }
+
+        EOSLIB_SERIALIZE(legacy_like_aggregate, (id)(node_id)(like_count))
+    };
+
+    struct legacy_vote_tally {
+        uint64_t    anchor_id;
+        checksum256 tx_hash;
+        uint64_t    up_weight = 0;
+        uint64_t    down_weight = 0;
+        uint32_t    up_voter_count = 0;
+        uint32_t    down_voter_count = 0;
+        time_point  updated_at;
+
+        uint64_t primary_key() const { return anchor_id; }
+        checksum256 by_hash() const { return tx_hash; }
+
+        EOSLIB_SERIALIZE(legacy_vote_tally, (anchor_id)(tx_hash)(up_weight)(down_weight)
+                                            (up_voter_count)(down_voter_count)(updated_at))
+    };
+
+    struct legacy_pending_reward {
+        uint64_t    id;
+        checksum256 node_id;
+        asset       amount;
+        time_point  earned_at;
+        time_point  last_updated;
+
+        uint64_t primary_key() const { return id; }
+        checksum256 by_node() const { return node_id; }
+
+        EOSLIB_SERIALIZE(legacy_pending_reward, (id)(node_id)(amount)(earned_at)(last_updated))
+    };
+
+    struct legacy_global_state {
+        uint64_t    x;
+        double      carry;
+        uint64_t    round;
+        name        fractally_oracle;
+        name        token_contract;
+        symbol      token_symbol;
+        name        council_account;
+        uint64_t    approval_threshold_bp;
+        uint32_t    max_vote_weight;
+        uint32_t    attestor_respect_threshold;
+        bool        paused;
+        uint32_t    vote_window_release;
+        uint32_t    vote_window_mint;
+        uint32_t    vote_window_resolve;
+        uint32_t    vote_window_claim;
+        uint32_t    vote_window_merge;
+        uint32_t    vote_window_default;
+        uint64_t    multiplier_release;
+        uint64_t    multiplier_mint;
+        uint64_t    multiplier_resolve;
+        uint64_t    multiplier_add_claim;
+        uint64_t    multiplier_edit_claim;
+        uint64_t    multiplier_merge;
+        uint64_t    approved_author_pct;
+        uint64_t    approved_voters_pct;
+        uint64_t    approved_stakers_pct;
+        uint64_t    rejected_voters_pct;
+        uint64_t    rejected_stakers_pct;
+
+        EOSLIB_SERIALIZE(legacy_global_state, (x)(carry)(round)(fractally_oracle)(token_contract)(token_symbol)(council_account)
+                        (approval_threshold_bp)(max_vote_weight)(attestor_respect_threshold)
+                        (paused)
+                        (vote_window_release)(vote_window_mint)(vote_window_resolve)
+                        (vote_window_claim)(vote_window_merge)(vote_window_default)
+                        (multiplier_release)(multiplier_mint)(multiplier_resolve)
+                        (multiplier_add_claim)(multiplier_edit_claim)(multiplier_merge)
+                        (approved_author_pct)(approved_voters_pct)(approved_stakers_pct)
+                        (rejected_voters_pct)(rejected_stakers_pct))
+    };
+
+    typedef eosio::multi_index<"anchors"_n, legacy_anchor,
+        indexed_by<"byhash"_n, const_mem_fun<legacy_anchor, checksum256, &legacy_anchor::by_hash>>,
+        indexed_by<"byauthor"_n, const_mem_fun<legacy_anchor, uint64_t, &legacy_anchor::by_author>>
+    > legacy_anchors_table;
+
+    typedef eosio::multi_index<"votes"_n, legacy_vote,
+        indexed_by<"byvoterhash"_n, const_mem_fun<legacy_vote, uint128_t, &legacy_vote::by_voter_hash>>,
+        indexed_by<"byhash"_n, const_mem_fun<legacy_vote, checksum256, &legacy_vote::by_hash>>
+    > legacy_votes_table;
+
+    typedef eosio::multi_index<"respect"_n, legacy_respect> legacy_respect_table;
+
+    typedef eosio::multi_index<"stakes"_n, legacy_stake,
+        indexed_by<"bynode"_n, const_mem_fun<legacy_stake, checksum256, &legacy_stake::by_node>>
+    > legacy_stakes_table;
+
+    typedef eosio::multi_index<"nodeagg"_n, legacy_node_aggregate,
+        indexed_by<"bynode"_n, const_mem_fun<legacy_node_aggregate, checksum256, &legacy_node_aggregate::by_node>>
+    > legacy_nodeagg_table;
+
+    typedef eosio::multi_index<"stakernodes"_n, legacy_staker_node,
+        indexed_by<"bynode"_n, const_mem_fun<legacy_staker_node, checksum256, &legacy_staker_node::by_node>>,
+        indexed_by<"byaccount"_n, const_mem_fun<legacy_staker_node, uint64_t, &legacy_staker_node::by_account>>,
+        indexed_by<"byaccnode"_n, const_mem_fun<legacy_staker_node, uint128_t, &legacy_staker_node::by_account_node>>
+    > legacy_staker_nodes_table;
+
+    typedef eosio::multi_index<"attestations"_n, legacy_attestation,
+        indexed_by<"byhash"_n, const_mem_fun<legacy_attestation, checksum256, &legacy_attestation::by_hash>>
+    > legacy_attestations_table;
+
+    typedef eosio::multi_index<"likes"_n, legacy_like,
+        indexed_by<"bynode"_n, const_mem_fun<legacy_like, checksum256, &legacy_like::by_node>>
+    > legacy_likes_table;
+
+    typedef eosio::multi_index<"likeagg"_n, legacy_like_aggregate,
+        indexed_by<"bynode"_n, const_mem_fun<legacy_like_aggregate, checksum256, &legacy_like_aggregate::by_node>>
+    > legacy_likeagg_table;
+
+    typedef eosio::multi_index<"votetally"_n, legacy_vote_tally,
+        indexed_by<"byhash"_n, const_mem_fun<legacy_vote_tally, checksum256, &legacy_vote_tally::by_hash>>
+    > legacy_votetally_table;
+
+    typedef eosio::multi_index<"pendingrwd"_n, legacy_pending_reward,
+        indexed_by<"bynode"_n, const_mem_fun<legacy_pending_reward, checksum256, &legacy_pending_reward::by_node>>
+    > legacy_pending_rewards_table;
+
+    typedef eosio::singleton<"globals"_n, legacy_global_state> legacy_globals_singleton;
+
+#ifdef PERF_STATS
+    /**
+     * @brief Work done by the current action
+     *
+     * Each action runs in a fresh WASM instance, so a static counter set
+     * starts at zero and only ever sees one action. Static also lets the
+     * static probe helpers count their reads.
+     *
+     * voters_iterated and stakers_iterated count the vote and stake rows
+     * walked by prune() and claimall(); settlement itself pays voters and
+     * stakers in O(1) through the tally share and reward accumulator.
+     * ram_bytes is the serialized size of emplaced rows, without the
+     * per-row overhead the chain adds.
+     */
+    struct perf_counters {
+        uint64_t rows_read;
+        uint64_t rows_written;
+        uint64_t inline_actions;
+        uint64_t voters_iterated;
+        uint64_t stakers_iterated;
+        uint64_t ram_bytes;
+    };
+
+    // Static storage, so zero-initialized
+    static inline perf_counters perf_counts;
+
+    typedef eosio::multi_index<"perfstats"_n, perf_row> perfstats_table;
+
+    /**
+     * @brief Flushes the counters into perfstats when the action returns
+     *
+     * Aborted actions roll the row back with the rest of the transaction,
+     * so only successful calls are counted.
+     */
+    struct perf_scope {
+        polaris& self;
+        name action;
+
+        ~perf_scope() { self.flush_perf(action); }
+    };
+
+    void flush_perf(name action) {
+        perfstats_table perfstats(get_self(), get_self().value);
+        auto apply = [&](perf_row& row) {
+            row.calls += 1;
+            row.rows_read += perf_counts.rows_read;
+            row.rows_written += perf_counts.rows_written;
+            row.inline_actions += perf_counts.inline_actions;
+            row.voters_iterated += perf_counts.voters_iterated;
+            row.stakers_iterated += perf_counts.stakers_iterated;
+            row.ram_bytes += perf_counts.ram_bytes;
+        };
+
+        auto itr = perfstats.find(action.value);
+        if (itr == perfstats.end()) {
+            perfstats.emplace(get_self(), [&](auto& row) {
+                row.action = action;
+                apply(row);
+            });
+        } else {
+            perfstats.modify(itr, same_payer, apply);
+        }
+        perf_counts = perf_counters{};
+    }
+#endif // PERF_STATS
 
     // ============ HELPER FUNCTIONS ============
 
@@ -1577,102 +3637,611 @@ private:
      * @brief Get global state and ensure contract is initialized
      */
     global_state get_globals() const {
+        PERF_ADD(rows_read, 1);
         globals_singleton globals(get_self(), get_self().value);
-        check(globals.exists(), "Contract not initialized - call init() first");
+        if (!globals.exists()) {
+            legacy_globals_singleton legacy(get_self(), get_self().value);
+            check(!legacy.exists(), "Schema migration required - call migrate() first");
+            check(false, "Contract not initialized - call init() first");
+        }
         return globals.get();
     }
 
     /**
-     * @brief Get voting window duration based on event type
+     * @brief Distribute an expired anchor's escrow and mark it finalized
+     *
+     * Shared by finalize() and crank(). The caller has checked that the
+     * anchor is unfinalized and its voting window has closed, saves g
+     * (running totals and the staker accumulator change here) and emits
+     * the returned summary in a finalevent notification.
+     */
+    settlement_summary settle_anchor(global_state& g, anchorstate_table& states, votetally_table& tallies,
+                       anchorstate_table::const_iterator anchor_itr) {
+        // Read aggregate tallies directly from on-chain tally table
+        // (no row: never voted on, settles as zero votes)
+        auto tally_itr = tallies.find(anchor_itr->anchor_id);
+        bool has_tally = (tally_itr != tallies.end());
+
+        uint64_t up_votes = has_tally ? tally_itr->up_weight : 0;
+        uint64_t down_votes = has_tally ? tally_itr->down_weight : 0;
+
+        // Retrieve escrowed amount (accounted at submission time, issued in bulk)
+        uint64_t escrowed_amount = anchor_itr->escrowed_amount;
+
+        // Determine payout distribution based on approval threshold
+        // Use integer basis points to avoid floating point comparison issues
+        // Default: 9000 basis points = 90.00% approval required (configurable via setparams)
+        bool accepted = polaris_core::is_accepted(up_votes, down_votes, g.approval_threshold_bp);
+
+        // Types that need attestation cannot be accepted without one
+        if (polaris_core::policy_of(anchor_itr->type).requires_attestation && anchor_itr->attestation_count == 0) {
+            accepted = false;
+        }
+
+        settlement_summary summary{};
+        summary.anchor_id = anchor_itr->anchor_id;
+        summary.tx_hash = anchor_itr->hash;
+        summary.accepted = accepted;
+        summary.up_weight = up_votes;
+        summary.down_weight = down_votes;
+        summary.escrowed_amount = escrowed_amount;
+
+        // Distribute escrowed tokens based on outcome
+        if(escrowed_amount > 0 && !has_tally) {
+            // Rejected with no voters: the voter share falls through to stakers
+            distribute_to_stakers(g, escrowed_amount);
+            summary.staker_amount = escrowed_amount;
+        } else if(escrowed_amount > 0) {
+            if(accepted) {
+                summary.author_amount = distribute_rewards_approved(g, tallies, tally_itr, anchor_itr->author,
+                                                                    escrowed_amount);
+            } else {
+                summary.staker_amount = distribute_rewards_rejected(g, tallies, tally_itr, escrowed_amount,
+                                                                    up_votes, down_votes);
+            }
+        }
+
+        // Running totals: escrow leaves the open pool, votes become settled.
+        // Guarded so an anchor the counters never saw cannot wrap them.
+        if (g.open_anchors > 0) g.open_anchors -= 1;
+        g.open_escrow -= std::min(g.open_escrow, escrowed_amount);
+
+        if (has_tally) {
+            summary.rewarded_side = tally_itr->rewarded_side;
+            summary.voter_share = tally_itr->voter_share;
+            if (summary.rewarded_side != 0) {
+                summary.rewarded_voters = summary.rewarded_side > 0 ? tally_itr->up_voter_count
+                                                                    : tally_itr->down_voter_count;
+            }
+            g.settled_votes += uint64_t(tally_itr->up_voter_count) + tally_itr->down_voter_count;
+        }
+
+        // Mark as finalized and zero out escrow
+        PERF_ADD(rows_written, 1);
+        states.modify(anchor_itr, same_payer, [&](auto& a) {
+            a.finalized = true;
+            a.escrowed_amount = 0;
+        });
+
+        return summary;
+    }
+
+    /**
+     * @brief Result of storing one anchor (see store_anchor)
+     */
+    struct anchor_receipt {
+        uint64_t anchor_id;
+        uint64_t submission_x;  // Value of g.x when the anchor was submitted
+        uint64_t mint;          // Escrow to mint for this anchor
+        uint32_t expires_at;    // When voting closes
+    };
+
+    /**
+     * @brief Remove a pruned reply from its parent's thread index
+     *
+     * Nothing to do if the parent was pruned first (its scope went with it).
+     *
+     * @return true if a thread index row was erased
+     */
+    bool unlink_child(anchorstate_table& states, const checksum256& parent_hash, uint64_t child_seq) {
+        auto parent_itr = find_anchor_state(states, parent_hash);
+        if (parent_itr == states.end()) return false;
+
+        children_table children(get_self(), parent_itr->anchor_id);
+        auto child_itr = children.find(child_seq);
+        if (child_itr == children.end()) return false;
+        PERF_ADD(rows_written, 1);
+        children.erase(child_itr);
+
+        PERF_ADD(rows_written, 1);
+        states.modify(parent_itr, same_payer, [&](auto& st) {
+            st.child_count = (st.child_count > 0) ? st.child_count - 1 : 0;
+        });
+        return true;
+    }
+
+    /**
+     * @brief Validate and store one anchor and its settlement state
+     *
+     * No tally row is created here: apply_vote() creates it on the first
+     * vote, and settlement treats a missing row as zero votes.
+     *
+     * Shared by put() and putbatch(). Computes the submission-time emission
+     * and advances g.x, the carry and the running totals in memory. The
+     * escrow is only added to g.unissued_escrow (issued later, see
+     * issueepoch); the caller persists globals and emits notifications.
+     */
+    anchor_receipt store_anchor(global_state& g, anchors_table& anchors, anchorstate_table& states,
+                                name author, const anchor_input& in, uint32_t current_time) {
+        // Validate inputs
+        const polaris_core::event_policy& policy = polaris_core::policy_of(in.type);
+        check(policy.valid, "Invalid event type");
+        check(in.ts >= MIN_VALID_TIMESTAMP, "Timestamp too far in past (minimum 2023-01-01)");
+        check(!in.event_cid.empty(), "Event CID is required");
+        check(in.event_cid.length() < 200, "Event CID too long (max 200 chars)");
+        check(in.tags.size() <= 10, "Too many tags (max 10)");
+
+        // Validate each tag format and length
+        for (const auto& tag : in.tags) {
+            check(tag.length() >= 3, "Tag too short (minimum 3 characters): " + tag.to_string());
+            check(tag.length() <= 12, "Tag too long (maximum 12 characters): " + tag.to_string());
+            // Note: Antelope name type already validates format (a-z, 1-5, dots only)
+        }
+
+        // Resolve the anchor key: first free slot in the hash's probe window
+        auto anchor_probe = probe_hash_key(states, in.hash, &anchor_state::hash);
+        auto existing = anchor_probe.first;
+        uint64_t anchor_key = anchor_probe.second;
+        check(existing == states.end(), "Event hash already exists");
+        prunedhash_table pruned(get_self(), get_self().value);
+        check(find_by_hash_key(pruned, in.hash, &pruned_hash::hash) == pruned.end(),
+              "Event hash already anchored (pruned)");
+
+        // Validate parent hash exists if provided
+        auto parent_itr = states.end();
+        if(in.parent.has_value()) {
+            parent_itr = find_anchor_state(states, in.parent.value());
+            check(parent_itr != states.end(), "Parent event not found");
+        }
+
+        check(in.ts <= current_time + 300, "Timestamp too far in future (max 5 min)");
+
+        // Calculate voting window based on event type
+        uint32_t expires_at = current_time + get_vote_window(g, policy);
+
+        // Store the anchor on-chain
+        uint64_t anchor_id = anchor_key;
+
+        // Capture submission-time x BEFORE incrementing (for escrow-based emission)
+        uint64_t submission_x = g.x;
+        bool content = policy.content;
+
+        // Calculate emission at submission time using submission_x
+        uint64_t multiplier = get_multiplier(g, policy);
+        uint64_t mint = 0;
+
+        if (policy.emits() && multiplier > 0 && submission_x >= 1) {
+            // Calculate emission using logarithmic curve: g(x) = m * ln(x) / x
+            // (clamped to MAX_MINT_Q32 so the mint fits in uint64_t)
+            auto minted = polaris_core::mint_with_carry(multiplier, submission_x, g.carry_q32);
+            mint = minted.mint;
+            g.carry_q32 = minted.carry_q32;
+        }
+
+        PERF_ADD(rows_written, 1);
+        anchors.emplace(author, [&](auto& a) {
+            a.id = anchor_id;
+            a.seq = g.anchor_count;
+            a.author = author;
+            a.type = in.type;
+            a.hash = in.hash;
+            a.event_cid = in.event_cid;
+            a.parent = in.parent;
+            a.ts = in.ts;
+            a.tags = in.tags;
+            PERF_RAM(a);
+        });
+
+        // Index the anchor under its parent's thread
+        if (parent_itr != states.end()) {
+            children_table children(get_self(), parent_itr->anchor_id);
+            PERF_ADD(rows_written, 1);
+            children.emplace(author, [&](auto& c) {
+                c.seq = g.anchor_count;
+                c.anchor_id = anchor_id;
+                PERF_RAM(c);
+            });
+            PERF_ADD(rows_written, 1);
+            states.modify(parent_itr, same_payer, [&](auto& st) {
+                st.child_count += 1;
+                st.last_child_at = current_time;
+            });
+        }
+
+        // Index the anchor under each of its tags (a repeated tag is indexed once)
+        for (const auto& tag : in.tags) {
+            tagindex_table tag_rows(get_self(), tag.value);
+            if (tag_rows.find(g.anchor_count) == tag_rows.end()) {
+                PERF_ADD(rows_written, 1);
+                tag_rows.emplace(author, [&](auto& t) {
+                    t.seq = g.anchor_count;
+                    t.anchor_id = anchor_id;
+                    PERF_RAM(t);
+                });
+            }
+        }
+
+        PERF_ADD(rows_written, 1);
+        states.emplace(author, [&](auto& st) {
+            st.anchor_id = anchor_id;
+            st.hash = in.hash;
+            st.author = author;
+            st.type = in.type;
+            st.expires_at = expires_at;
+            st.finalized = false;
+            st.escrowed_amount = mint;
+            st.submission_x = submission_x;
+            PERF_RAM(st);
+        });
+
+        // NOW increment global submission counter AFTER capturing submission_x
+        // Only increment for content submissions, not votes/likes/discussions
+        if (content) {
+            g.x += 1; // Global submission number
+        }
+        g.anchor_count += 1;
+        g.open_anchors += 1;
+        g.open_escrow += mint;
+        g.unissued_escrow += mint;
+
+        return anchor_receipt{anchor_id, submission_x, mint, expires_at};
+    }
+
+    /**
+     * @brief Get voting window duration of an event type's policy
      *
      * Different event types have different voting windows to allow
      * appropriate community review time. Values are configurable via
      * setvwindows() action.
      */
-    uint32_t get_vote_window(uint8_t type) const {
-        auto g = get_globals();
-
-        if(type == 21) return g.vote_window_release;    // CREATE_RELEASE_BUNDLE
-        if(type == 22) return g.vote_window_mint;       // MINT_ENTITY
-        if(type == 23) return g.vote_window_resolve;    // RESOLVE_ID
-        if(type == 30 || type == 31) return g.vote_window_claim; // ADD_CLAIM / EDIT_CLAIM
-        if(type == 60) return g.vote_window_merge;      // MERGE_ENTITY
-        return g.vote_window_default;                   // Default for other types
+    uint32_t get_vote_window(const global_state& g, const polaris_core::event_policy& policy) const {
+        // Indexed by polaris_core::window_slot
+        static constexpr uint32_t global_state::* windows[] = {
+            &global_state::vote_window_default,
+            &global_state::vote_window_release,
+            &global_state::vote_window_mint,
+            &global_state::vote_window_resolve,
+            &global_state::vote_window_claim,
+            &global_state::vote_window_merge,
+        };
+        return g.*windows[static_cast<uint8_t>(policy.window)];
     }
 
     /**
-     * @brief Get emission multiplier for event type
+     * @brief Get emission multiplier of an event type's policy
      *
      * Higher multipliers for more valuable contributions.
      * The logarithmic curve applies to the multiplier.
      * Values are configurable via setmults() action.
      */
-    uint64_t get_multiplier(uint8_t type) const {
-        auto g = get_globals();
+    uint64_t get_multiplier(const global_state& g, const polaris_core::event_policy& policy) const {
+        // Indexed by polaris_core::multiplier_slot (none: no emission)
+        static constexpr uint64_t global_state::* multipliers[] = {
+            nullptr,
+            &global_state::multiplier_release,
+            &global_state::multiplier_mint,
+            &global_state::multiplier_resolve,
+            &global_state::multiplier_add_claim,
+            &global_state::multiplier_edit_claim,
+            &global_state::multiplier_merge,
+        };
+        auto field = multipliers[static_cast<uint8_t>(policy.multiplier)];
+        return field ? g.*field : 0;
+    }
+
+    /**
+     * @brief Create composite key for multi-index secondary indexes
+     *
+     * Combines account name and checksum256 into a uint128_t key.
+     */
+    static uint128_t combine_keys(uint64_t a, const checksum256& b) {
+        // Use first 64 bits of checksum256
+        return polaris_core::combine_keys(a, hash_prefix(b));
+    }
+
+    /**
+     * @brief First 64 bits of a checksum256, big-endian
+     */
+    static uint64_t hash_prefix(const checksum256& hash) {
+        auto hash_data = hash.extract_as_byte_array();
+        return polaris_core::hash_prefix(hash_data.data());
+    }
+
+    /**
+     * @brief Find a row whose primary key is derived from a checksum256
+     *
+     * Tables keyed this way store each row at the first free key among
+     * hash_slot(hash_prefix(hash), 0 .. HASH_PROBE_WINDOW-1) (linear
+     * probing, see probe_hash_key), or at an overflow key recorded in
+     * hashoverflow once those slots are taken. A lookup is a primary find
+     * per probed slot, normally just the first one. The whole window and
+     * the overflow index are checked on a miss, so a freed slot never
+     * hides a later row.
+     *
+     * @param field - Row member holding the full hash
+     */
+    template<typename Table, typename Row>
+    static typename Table::const_iterator find_by_hash_key(const Table& table, const checksum256& hash,
+                                                           checksum256 Row::*field) {
+        auto itr = table.end();
+        auto window = probe_slots(table, hash, field, itr);
+        if (window.found) return itr;
+        return find_overflow_row(table, hash, field);
+    }
 
-        switch(type) {
-            case 21: return g.multiplier_release;     // CREATE_RELEASE_BUNDLE
-            case 22: return g.multiplier_mint;        // MINT_ENTITY
-            case 23: return g.multiplier_resolve;     // RESOLVE_ID
-            case 30: return g.multiplier_add_claim;   // ADD_CLAIM
-            case 31: return g.multiplier_edit_claim;  // EDIT_CLAIM
-            case 60: return g.multiplier_merge;       // MERGE_ENTITY
-            default: return 0;                        // No emission (votes, likes, etc.)
+    /**
+     * @brief Scan a hash's probe window (see polaris_core::probe_window)
+     *
+     * @param match - Set to the row holding the hash when one is found
+     */
+    template<typename Table, typename Row>
+    static polaris_core::window_probe probe_slots(const Table& table, const checksum256& hash,
+                                                  checksum256 Row::*field,
+                                                  typename Table::const_iterator& match) {
+        return polaris_core::probe_window(hash_prefix(hash), [&](uint64_t key) {
+            PERF_ADD(rows_read, 1);
+            auto itr = table.find(key);
+            if (itr == table.end()) return polaris_core::slot_state::empty;
+            if ((*itr).*field != hash) return polaris_core::slot_state::other;
+            match = itr;
+            return polaris_core::slot_state::match;
+        });
+    }
+
+    /**
+     * @brief Find a hash-keyed row, or the key to insert it at
+     *
+     * Single pass over the probe window for insert-or-update paths. When
+     * every slot is taken by other hashes the key comes from the overflow
+     * range instead, and its hashoverflow entry is written here (billed to
+     * the contract), so the caller must insert the row on a miss.
+     *
+     * @return (row, key): row is end() if absent, key is then the key to insert at
+     */
+    template<typename Table, typename Row>
+    std::pair<typename Table::const_iterator, uint64_t>
+    probe_hash_key(const Table& table, const checksum256& hash, checksum256 Row::*field) {
+        auto match = table.end();
+        auto window = probe_slots(table, hash, field, match);
+        if (window.found) return {match, window.key};
+
+        // The row may sit in the overflow range even when a slot has since freed up
+        hash_overflow_table overflow(get_self(), get_self().value);
+        auto by_lookup = overflow.get_index<"bylookup"_n>();
+        checksum256 lookup = overflow_lookup(table, hash);
+        PERF_ADD(rows_read, 1);
+        auto entry = by_lookup.find(lookup);
+        if (entry != by_lookup.end()) {
+            auto itr = table.find(entry->key);
+            if (itr != table.end() && (*itr).*field == hash) return {itr, entry->key};
         }
+        if (window.has_free) return {table.end(), window.free_key};
+
+        // Window full: next key above every overflow key in use
+        uint64_t key = polaris_core::overflow_key(table.available_primary_key());
+        if (entry != by_lookup.end()) {
+            // Entry left behind by an erased row: repoint it
+            PERF_ADD(rows_written, 1);
+            by_lookup.modify(entry, same_payer, [&](auto& o) {
+                o.key = key;
+            });
+        } else {
+            PERF_ADD(rows_written, 1);
+            overflow.emplace(get_self(), [&](auto& o) {
+                o.id = overflow.available_primary_key();
+                o.key = key;
+                o.lookup = lookup;
+                PERF_RAM(o);
+            });
+        }
+        return {table.end(), key};
     }
 
     /**
-     * @brief Check if event type requires attestation before finalization
+     * @brief Drop the hashoverflow entry of a row about to be erased
+     *
+     * No-op for rows stored in their probe window.
      */
-    bool requires_attestation(uint8_t /*type*/) const {
-        return false; // Attestation disabled until Respect + governance is fully implemented
+    template<typename Table>
+    void release_hash_key(const Table& table, uint64_t key, const checksum256& hash) {
+        if (key < OVERFLOW_KEY_BASE) return;
+        hash_overflow_table overflow(get_self(), get_self().value);
+        auto by_lookup = overflow.get_index<"bylookup"_n>();
+        PERF_ADD(rows_read, 1);
+        auto entry = by_lookup.find(overflow_lookup(table, hash));
+        if (entry != by_lookup.end() && entry->key == key) {
+            PERF_ADD(rows_written, 1);
+            by_lookup.erase(entry);
+        }
     }
 
     /**
-     * @brief Create composite key for multi-index secondary indexes
+     * @brief Look up a row stored at an overflow key
+     */
+    template<typename Table, typename Row>
+    static typename Table::const_iterator find_overflow_row(const Table& table, const checksum256& hash,
+                                                            checksum256 Row::*field) {
+        hash_overflow_table overflow(table.get_code(), table.get_code().value);
+        auto by_lookup = overflow.get_index<"bylookup"_n>();
+        PERF_ADD(rows_read, 1);
+        auto entry = by_lookup.find(overflow_lookup(table, hash));
+        if (entry == by_lookup.end()) return table.end();
+        // An entry can outlive its row; only a row carrying the hash counts
+        auto itr = table.find(entry->key);
+        if (itr != table.end() && (*itr).*field == hash) return itr;
+        return table.end();
+    }
+
+    template<typename Table> struct table_name_of;
+    template<name::raw TableName, typename Row, typename... Indices>
+    struct table_name_of<eosio::multi_index<TableName, Row, Indices...>> {
+        static constexpr name value = name(TableName);
+    };
+
+    /**
+     * @brief hashoverflow key for a hash in one table and scope
+     */
+    template<typename Table>
+    static checksum256 overflow_lookup(const Table& table, const checksum256& hash) {
+        auto packed = pack(std::make_tuple(table_name_of<Table>::value, table.get_scope(), hash));
+        return sha256(packed.data(), packed.size());
+    }
+
+    /**
+     * @brief Find an anchor's settlement row by event hash
+     */
+    anchorstate_table::const_iterator find_anchor_state(const anchorstate_table& states,
+                                                        const checksum256& hash) const {
+        return find_by_hash_key(states, hash, &anchor_state::hash);
+    }
+
+    /**
+     * @brief Check if account is authorized to provide attestations
      *
-     * Combines account name and checksum256 into a uint128_t key.
+     * In production, this should check against a dedicated table or
+     * multisig authority.
      */
-    static uint128_t combine_keys(uint64_t a, const checksum256& b) {
-        // Use first 64 bits of checksum256
-        auto hash_data = b.extract_as_byte_array();
-        uint64_t b_part = 0;
-        for(int i = 0; i < 8; i++) {
-            b_part = (b_part << 8) | hash_data[i];
+    bool is_authorized_attestor(const global_state& g, name account) const {
+        // Check if it's the Fractally oracle
+        if(account == g.fractally_oracle) return true;
+
+        // Check if it's the designated council account (if configured)
+        if(g.council_account.value != 0 && account == g.council_account) return true;
+
+        // Check Respect threshold (configurable via setparams)
+        respect_table respect(get_self(), get_self().value);
+        auto itr = respect.find(account.value);
+        if(itr != respect.end() && effective_respect(*itr, g) >= g.attestor_respect_threshold) {
+            return true; // High Respect members can attest
         }
-        return (uint128_t(a) << 64) | uint128_t(b_part);
+
+        return false;
+    }
+
+    /**
+     * @brief Respect value of a row in effect for the committed round
+     *
+     * See polaris_core::effective_respect.
+     */
+    static uint32_t effective_respect(const respect_record& r, const global_state& g) {
+        return polaris_core::effective_respect(r.respect, r.staged_respect, r.staged_round, g.round);
     }
 
     /**
-     * @brief Get authorized Fractally oracle account
+     * @brief Resolve a voter's Respect weight (default 1, capped at max_vote_weight)
      */
-    name get_fractally_oracle() const {
-        auto g = get_globals();
-        return g.fractally_oracle;
+    uint32_t get_vote_weight(const global_state& g, name voter) const {
+        respect_table respect(get_self(), get_self().value);
+        auto respect_itr = respect.find(voter.value);
+        uint32_t voter_respect = 1; // Default weight if no Respect
+
+        if(respect_itr != respect.end() && effective_respect(*respect_itr, g) > 0) {
+            voter_respect = effective_respect(*respect_itr, g);
+            if(voter_respect > g.max_vote_weight) {
+                voter_respect = g.max_vote_weight;
+            }
+        }
+        return voter_respect;
     }
 
     /**
-     * @brief Check if account is authorized to provide attestations
+     * @brief Apply one vote to an anchor's tally and vote scope
      *
-     * In production, this should check against a dedicated table or
-     * multisig authority.
+     * Shared by vote() and votebatch(). Every precondition is checked before
+     * any write, so a non-zero status means no state was changed.
+     *
+     * @param anchor_id - Set to the voted anchor's ID when the vote is applied
+     * @return VOTE_APPLIED or the VOTE_* code of the failed precondition
      */
-    bool is_authorized_attestor(name account) const {
-        // Check if it's the Fractally oracle
-        if(account == get_fractally_oracle()) return true;
+    uint8_t apply_vote(anchorstate_table& states, votetally_table& tallies, name voter,
+                       uint32_t voter_respect, const checksum256& tx_hash, int8_t val, uint32_t now,
+                       uint64_t& anchor_id) {
+        if(val < -1 || val > 1) return VOTE_INVALID_VALUE;
 
-        // Check if it's the designated council account (if configured)
-        auto g = get_globals();
-        if(g.council_account.value != 0 && account == g.council_account) return true;
+        // Verify the anchor exists and voting window is still open
+        auto anchor_itr = find_anchor_state(states, tx_hash);
+        if(anchor_itr == states.end()) return VOTE_ANCHOR_NOT_FOUND;
+        if(anchor_itr->finalized) return VOTE_FINALIZED;
+        if(now >= anchor_itr->expires_at) return VOTE_WINDOW_CLOSED;
+        if(!polaris_core::policy_of(anchor_itr->type).votable) return VOTE_NOT_VOTABLE;
+
+        // Resolve tally row for this anchor; the first vote creates it
+        PERF_ADD(rows_read, 1);
+        auto tally_itr = tallies.find(anchor_itr->anchor_id);
+        if(tally_itr == tallies.end()) {
+            if(val == 0) {
+                anchor_id = anchor_itr->anchor_id;
+                return VOTE_APPLIED; // Nothing to withdraw
+            }
+            PERF_ADD(rows_written, 1);
+            tally_itr = tallies.emplace(voter, [&](auto& t) {
+                t.anchor_id = anchor_itr->anchor_id;
+                t.tx_hash = anchor_itr->hash;
+                t.updated_at = current_time_point();
+                PERF_RAM(t);
+            });
+        }
 
-        // Check Respect threshold (configurable via setparams)
-        respect_table respect(get_self(), get_self().value);
-        auto itr = respect.find(account.value);
-        if(itr != respect.end() && itr->respect >= g.attestor_respect_threshold) {
-            return true; // High Respect members can attest
+        // Find existing vote of this voter in the anchor's scope
+        votes_table votes(get_self(), anchor_itr->anchor_id);
+        PERF_ADD(rows_read, 1);
+        auto vote_itr = votes.find(voter.value);
+
+        bool has_old_vote = (vote_itr != votes.end());
+
+        // Remove old vote contribution from tally
+        if(has_old_vote) {
+            tally_remove_contribution(tallies, tally_itr, vote_itr->val, vote_itr->weight);
         }
 
-        return false;
+        if(val == 0) {
+            // Clear vote: erase row, tally already decremented above
+            if(has_old_vote) {
+                PERF_ADD(rows_written, 1);
+                votes.erase(vote_itr);
+            }
+        } else {
+            // Add or update vote row
+            if(!has_old_vote) {
+                PERF_ADD(rows_written, 1);
+                votes.emplace(voter, [&](auto& v) {
+                    v.voter = voter;
+                    v.val = val;
+                    v.weight = voter_respect;
+                    v.ts = current_time_point();
+                    PERF_RAM(v);
+                });
+            } else {
+                PERF_ADD(rows_written, 1);
+                votes.modify(vote_itr, voter, [&](auto& v) {
+                    v.val = val;
+                    v.weight = voter_respect;
+                    v.ts = current_time_point();
+                });
+            }
+
+            // Add new vote contribution to tally
+            tally_add_contribution(tallies, tally_itr, val, voter_respect);
+        }
+
+        // Update tally timestamp
+        PERF_ADD(rows_written, 1);
+        tallies.modify(tally_itr, same_payer, [&](auto& t) {
+            t.updated_at = current_time_point();
+        });
+
+        anchor_id = anchor_itr->anchor_id;
+        return VOTE_APPLIED;
     }
 
     /**
@@ -1683,13 +4252,7 @@ private:
                                     int8_t old_val, uint32_t old_weight) {
         if(old_val == 0) return; // No contribution to remove
         tallies.modify(tally_itr, same_payer, [&](auto& t) {
-            if(old_val == 1) {
-                t.up_weight = (t.up_weight >= old_weight) ? t.up_weight - old_weight : 0;
-                t.up_voter_count = (t.up_voter_count > 0) ? t.up_voter_count - 1 : 0;
-            } else if(old_val == -1) {
-                t.down_weight = (t.down_weight >= old_weight) ? t.down_weight - old_weight : 0;
-                t.down_voter_count = (t.down_voter_count > 0) ? t.down_voter_count - 1 : 0;
-            }
+            polaris_core::tally_remove(t, old_val, old_weight);
         });
     }
 
@@ -1700,14 +4263,9 @@ private:
                                  votetally_table::const_iterator tally_itr,
                                  int8_t val, uint32_t weight) {
         if(val == 0) return;
+        PERF_ADD(rows_written, 1);
         tallies.modify(tally_itr, same_payer, [&](auto& t) {
-            if(val == 1) {
-                t.up_weight += weight;
-                t.up_voter_count += 1;
-            } else if(val == -1) {
-                t.down_weight += weight;
-                t.down_voter_count += 1;
-            }
+            polaris_core::tally_add(t, val, weight);
         });
     }
 
@@ -1716,23 +4274,20 @@ private:
      *
      * @return pair<up_votes, down_votes> weighted by Respect
      */
-    std::pair<uint64_t, uint64_t> calculate_weighted_votes(const checksum256& tx_hash) const {
-        votes_table votes(get_self(), get_self().value);
-        auto hash_idx = votes.get_index<"byhash"_n>();
+    std::pair<uint64_t, uint64_t> calculate_weighted_votes(uint64_t anchor_id) const {
+        votes_table votes(get_self(), anchor_id);
 
         uint64_t up_votes = 0;
         uint64_t down_votes = 0;
 
-        // Iterate through all votes for this hash
-        auto itr = hash_idx.lower_bound(tx_hash);
-        while(itr != hash_idx.end() && itr->tx_hash == tx_hash) {
+        // Iterate through all votes in this anchor's scope
+        for(auto itr = votes.begin(); itr != votes.end(); ++itr) {
             if(itr->val == 1) {
                 up_votes += itr->weight;
             } else if(itr->val == -1) {
                 down_votes += itr->weight;
             }
             // val == 0 is neutral, doesn't count
-            ++itr;
         }
 
         return {up_votes, down_votes};
@@ -1744,29 +4299,32 @@ private:
      * Distribution:
      * - 50% to author (configurable via approved_author_pct)
      * - 50% to voters who voted YES, distributed equally (configurable via approved_voters_pct)
+     *
+     * @return Amount credited to the author
      */
-    void distribute_rewards_approved(name author, const checksum256& tx_hash, uint64_t total_amount) {
-        if(total_amount == 0) return;
-
-        auto g = get_globals();
+    uint64_t distribute_rewards_approved(const global_state& g, votetally_table& tallies,
+                                         votetally_table::const_iterator tally_itr,
+                                         name author, uint64_t total_amount) {
+        if(total_amount == 0) return 0;
 
         // Calculate shares based on configured ratios
-        uint64_t author_share = (total_amount * g.approved_author_pct) / 10000;
+        uint64_t author_share = polaris_core::bp_share(total_amount, g.approved_author_pct);
         uint64_t voters_share = total_amount - author_share;
 
         // Distribute to voters who voted YES (equal distribution among voters)
         // Do voters first so remainder can be added to author share
         uint64_t remainder = 0;
         if (voters_share > 0) {
-            remainder = distribute_to_voters(tx_hash, voters_share, true);
+            remainder = distribute_to_voters(tallies, tally_itr, voters_share, true);
         }
 
-        // Transfer to author (including any voter rounding remainder)
+        // Credit author (including any voter rounding remainder); finalize
+        // may be called by anyone, so the contract pays for a new balance row
         uint64_t author_total = author_share + remainder;
         if (author_total > 0) {
-            transfer_tokens(get_self(), author, asset(author_total, g.token_symbol),
-                           "Approved submission reward");
+            credit_balance(g, author, author_total, get_self());
         }
+        return author_total;
     }
 
     /**
@@ -1775,27 +4333,29 @@ private:
      * Distribution:
      * - 50% to voters who voted NO, distributed equally (configurable via rejected_voters_pct)
      * - 50% to stakers (configurable via rejected_stakers_pct)
+     *
+     * @return Amount distributed to stakers
      */
-    void distribute_rewards_rejected(const checksum256& tx_hash, uint64_t total_amount,
-                                    uint64_t up_votes, uint64_t down_votes) {
-        if(total_amount == 0) return;
-
-        auto g = get_globals();
+    uint64_t distribute_rewards_rejected(global_state& g, votetally_table& tallies,
+                                         votetally_table::const_iterator tally_itr, uint64_t total_amount,
+                                         uint64_t up_votes, uint64_t down_votes) {
+        if(total_amount == 0) return 0;
 
         // Calculate shares based on configured ratios
-        uint64_t voters_share = (total_amount * g.rejected_voters_pct) / 10000;
+        uint64_t voters_share = polaris_core::bp_share(total_amount, g.rejected_voters_pct);
         uint64_t stakers_share = total_amount - voters_share;
 
         // Distribute to voters who voted NO (down voters, equal distribution)
         uint64_t remainder = 0;
         if (voters_share > 0) {
-            remainder = distribute_to_voters(tx_hash, voters_share, false);
+            remainder = distribute_to_voters(tallies, tally_itr, voters_share, false);
         }
 
         // Distribute to stakers (including any voter rounding remainder)
         if (stakers_share + remainder > 0) {
-            distribute_to_stakers(stakers_share + remainder);
+            distribute_to_stakers(g, stakers_share + remainder);
         }
+        return stakers_share + remainder;
     }
 
     /**
@@ -1804,150 +4364,134 @@ private:
      * Each voter receives an equal share of the total amount, regardless of their
      * Respect value. This provides fair compensation for voting participation.
      *
-     * Uses checks-effects-interactions pattern to prevent reentrancy:
-     * 1. Count voters
-     * 2. Calculate equal shares
-     * 3. Issue all tokens (external calls)
+     * Pull-based: the voter count comes from the tally row, and only the
+     * per-voter share and the rewarded side are recorded on it. Each voter
+     * collects their share with claimvote(), so finalize() cost does not
+     * depend on the number of voters.
      *
-     * @param tx_hash - Event hash to distribute rewards for
+     * @param tallies - Tally table of the anchor being finalized
+     * @param tally_itr - Tally row of the anchor being finalized
      * @param total_amount - Total amount to distribute
      * @param up_voters_only - If true, distribute only to YES voters; if false, only to NO voters
      * @return Remainder amount not distributed (due to integer division)
      */
-    uint64_t distribute_to_voters(const checksum256& tx_hash, uint64_t total_amount, bool up_voters_only) {
+    uint64_t distribute_to_voters(votetally_table& tallies, votetally_table::const_iterator tally_itr,
+                                  uint64_t total_amount, bool up_voters_only) {
         if(total_amount == 0) return 0;
 
-        auto g = get_globals();
-        votes_table votes(get_self(), get_self().value);
-        auto hash_idx = votes.get_index<"byhash"_n>();
-
-        // Determine which vote value we're looking for (+1 for up voters, -1 for down voters)
-        int8_t target_vote = up_voters_only ? 1 : -1;
-
-        // First pass: count target voters
-        uint32_t voter_count = 0;
-        auto itr = hash_idx.lower_bound(tx_hash);
-        while(itr != hash_idx.end() && itr->tx_hash == tx_hash) {
-            if(itr->val == target_vote) {
-                voter_count++;
-            }
-            ++itr;
-        }
-
-        if(voter_count == 0) return total_amount;
+        uint32_t voter_count = up_voters_only ? tally_itr->up_voter_count : tally_itr->down_voter_count;
 
         // Calculate equal share per voter
-        uint64_t share_per_voter = total_amount / voter_count;
-        if(share_per_voter == 0) return total_amount;
-
-        // Calculate remainder (total - distributed)
-        uint64_t distributed = share_per_voter * voter_count;
-        uint64_t remainder = total_amount - distributed;
-
-        // Second pass: collect all voters (avoid reentrancy)
-        std::vector<name> voters;
-        itr = hash_idx.lower_bound(tx_hash);
-        while(itr != hash_idx.end() && itr->tx_hash == tx_hash) {
-            if(itr->val == target_vote) {
-                voters.push_back(itr->voter);
-            }
-            ++itr;
-        }
+        auto split = polaris_core::split_equally(total_amount, voter_count);
+        if(split.share == 0) return total_amount;
 
-        // Third pass: execute all token transfers from escrow (external calls last)
-        std::string memo = up_voters_only ? "YES vote reward" : "NO vote reward";
-        for(const auto& voter : voters) {
-            transfer_tokens(get_self(), voter, asset(share_per_voter, g.token_symbol), memo);
-        }
+        // Record claimable share; voters pull it via claimvote()
+        PERF_ADD(rows_written, 1);
+        tallies.modify(tally_itr, same_payer, [&](auto& t) {
+            t.rewarded_side = up_voters_only ? 1 : -1;
+            t.voter_share = split.share;
+        });
 
-        return remainder;
+        // Remainder (total - distributed)
+        return split.remainder;
     }
 
     /**
      * @brief Distribute rewards to all stakers proportionally
      *
-     * Records pending rewards for stakers based on their stake proportion.
-     * Stakers must call claimreward() or claimall() to collect rewards.
-     *
-     * IMPLEMENTATION:
-     * 1. Calculate total staked across all nodes
-     * 2. For each node, calculate its share of total rewards
-     * 3. For each staker on the node, record their proportional pending reward
-     * 4. Stakers claim rewards on-demand via claimreward()/claimall() actions
+     * Advances the global reward-per-stake accumulator instead of writing a
+     * row per staker. Each position earns amount * (reward_per_stake - snapshot)
+     * which is settled lazily in stake(), unstake(), claimreward() and claimall().
+     * Splitting by node share and then by stake within the node is equivalent
+     * to splitting by stake over the global total, so a single accumulator suffices.
      *
      * SCALABILITY:
-     * This approach scales well because:
-     * - Rewards are recorded lazily (only when submissions are rejected)
-     * - Claiming is on-demand (doesn't require iterating all stakers)
-     * - No CPU limit issues (each finalize() only processes relevant stakers)
+     * O(1) regardless of how many stakers or nodes exist.
+     *
+     * OVERFLOW:
+     * Every increment is scaled by 1 / total_staked and no position exceeds
+     * total_staked, so amount * (reward_per_stake - snapshot) is bounded by
+     * the rewards distributed since settlement times REWARD_PRECISION (see
+     * polaris.core.hpp), which
+     * fits in 128 bits for any int64 token supply.
+     *
+     * @param g - Globals loaded by the calling action (accumulator is updated in place)
+     * @param total_amount - Reward amount to credit to all stakers
      */
-    void distribute_to_stakers(uint64_t total_amount) {
+    void distribute_to_stakers(global_state& g, uint64_t total_amount) {
         if(total_amount == 0) return;
+        if(g.total_staked == 0) return; // No stakers: amount stays in contract
 
-        auto g = get_globals();
-        nodeagg_table aggregates(get_self(), get_self().value);
+        g.reward_per_stake += polaris_core::reward_per_stake_increment(total_amount, g.total_staked);
+    }
 
-        // Calculate total staked across all nodes
-        uint64_t total_staked = 0;
-        for(auto itr = aggregates.begin(); itr != aggregates.end(); ++itr) {
-            total_staked += itr->total.amount;
+    /**
+     * @brief Rewards accrued on a stake position since its last settlement
+     */
+    static uint64_t accrued_reward(const stake_record& s, const global_state& g) {
+        return polaris_core::accrued_reward(s.amount.amount, g.reward_per_stake, s.reward_snapshot);
+    }
+
+    /**
+     * @brief Record settled staker rewards in the account's pendingrwd table
+     */
+    void credit_pending_reward(name account, const checksum256& node_id, const asset& reward) {
+        pending_rewards_table pending(get_self(), account.value);
+        auto pending_probe = probe_hash_key(pending, node_id, &pending_reward::node_id);
+        auto pending_itr = pending_probe.first;
+        uint64_t pending_key = pending_probe.second;
+
+        if (pending_itr == pending.end()) {
+            PERF_ADD(rows_written, 1);
+            pending.emplace(account, [&](auto& p) {
+                p.id = pending_key;
+                p.node_id = node_id;
+                p.amount = reward;
+                p.earned_at = current_time_point();
+                p.last_updated = current_time_point();
+                PERF_RAM(p);
+            });
+        } else {
+            PERF_ADD(rows_written, 1);
+            pending.modify(pending_itr, same_payer, [&](auto& p) {
+                p.amount += reward;
+                p.last_updated = current_time_point();
+            });
         }
+    }
 
-        if(total_staked == 0) return;
-
-        staker_nodes_table staker_nodes(get_self(), get_self().value);
-        auto node_idx = staker_nodes.get_index<"bynode"_n>();
-
-        // Distribute proportionally to each node's stakers
-        for(auto node_itr = aggregates.begin(); node_itr != aggregates.end(); ++node_itr) {
-            // Calculate this node's share of total rewards (use 128-bit to prevent overflow)
-            uint64_t node_share = (static_cast<uint128_t>(total_amount) * node_itr->total.amount) / total_staked;
-            if(node_share == 0) continue;
-
-            uint64_t node_total = node_itr->total.amount;
-
-            // Iterate all stakers on this node
-            auto staker_itr = node_idx.lower_bound(node_itr->node_id);
-            while(staker_itr != node_idx.end() && staker_itr->node_id == node_itr->node_id) {
-                // Calculate this staker's share of node rewards (proportional to their stake)
-                uint64_t staker_share = (static_cast<uint128_t>(node_share) * staker_itr->amount.amount) / node_total;
-                if(staker_share > 0) {
-                    // Record pending reward for this staker
-                    pending_rewards_table pending(get_self(), staker_itr->account.value);
-                    auto pending_by_node = pending.get_index<"bynode"_n>();
-                    auto pending_itr = pending_by_node.find(node_itr->node_id);
-
-                    asset reward = asset(staker_share, g.token_symbol);
-
-                    if (pending_itr == pending_by_node.end()) {
-                        // New pending reward
-                        pending.emplace(get_self(), [&](auto& p) {
-                            p.id = pending.available_primary_key();
-                            p.node_id = node_itr->node_id;
-                            p.amount = reward;
-                            p.earned_at = current_time_point();
-                            p.last_updated = current_time_point();
-                        });
+    /**
+     * @brief Credit tokens held in escrow to an account's withdrawable balance
+     *
+     * @param payer - Pays for the balance row if it has to be created
+     */
+    void credit_balance(const global_state& g, name owner, uint64_t amount, name payer) {
+        if(amount == 0) return;
 
-                    } else {
-                        // Add to existing pending reward
-                        pending.modify(pending.iterator_to(*pending_itr), get_self(), [&](auto& p) {
-                            p.amount += reward;
-                            p.last_updated = current_time_point();
-                        });
-                    }
-                }
-                ++staker_itr;
-            }
+        balances_table balances(get_self(), get_self().value);
+        auto itr = balances.find(owner.value);
+        if(itr == balances.end()) {
+            PERF_ADD(rows_written, 1);
+            balances.emplace(payer, [&](auto& b) {
+                b.account = owner;
+                b.balance = asset(amount, g.token_symbol);
+                b.last_updated = current_time_point();
+                PERF_RAM(b);
+            });
+        } else {
+            PERF_ADD(rows_written, 1);
+            balances.modify(itr, same_payer, [&](auto& b) {
+                b.balance.amount += amount;
+                b.last_updated = current_time_point();
+            });
         }
     }
 
     /**
      * @brief Transfer tokens using inline action to token contract
      */
-    void transfer_tokens(name from, name to, asset quantity, const std::string& memo) {
-        auto g = get_globals();
-
+    void transfer_tokens(const global_state& g, name from, name to, asset quantity, const std::string& memo) {
+        PERF_ADD(inline_actions, 1);
         action(
             permission_level{from, "active"_n},
             g.token_contract,
@@ -1959,14 +4503,14 @@ private:
     /**
      * @brief Issue new tokens to an account
      */
-    void issue_tokens(name to, uint64_t amount, const std::string& memo) {
+    void issue_tokens(const global_state& g, name to, uint64_t amount, const std::string& memo) {
         if(amount == 0) return;
 
-        auto g = get_globals();
         check(amount <= static_cast<uint64_t>(std::numeric_limits<int64_t>::max()),
               "Issue amount exceeds int64 maximum");
         asset quantity = asset(static_cast<int64_t>(amount), g.token_symbol);
 
+        PERF_ADD(inline_actions, 1);
         action(
             permission_level{get_self(), "active"_n},
             g.token_contract,
@@ -1975,42 +4519,88 @@ private:
         ).send();
     }
 
+    /**
+     * @brief Issue up to `limit` of the pending escrow to the contract
+     *
+     * Issued in int64-sized chunks, since an asset amount is signed. The
+     * issued amount is taken off g.unissued_escrow.
+     */
+    void issue_escrow(global_state& g, uint64_t limit) {
+        uint64_t remaining = std::min(limit, g.unissued_escrow);
+        while (remaining > 0) {
+            uint64_t amount = std::min(remaining,
+                                       static_cast<uint64_t>(std::numeric_limits<int64_t>::max()));
+            issue_tokens(g, get_self(), amount, "Polaris escrow");
+            g.unissued_escrow -= amount;
+            remaining -= amount;
+        }
+    }
+
+    /**
+     * @brief Row of the token contract's stat table (eosio.token standard)
+     *
+     * Read from token_contract, scoped by symbol code. Not a table of this
+     * contract, so it carries no [[eosio::table]] and stays out of the ABI.
+     */
+    struct currency_stats {
+        asset    supply;
+        asset    max_supply;
+        name     issuer;
+
+        uint64_t primary_key() const { return supply.symbol.code().raw(); }
+
+        EOSLIB_SERIALIZE(currency_stats, (supply)(max_supply)(issuer))
+    };
+
+    typedef eosio::multi_index<"stat"_n, currency_stats> stats_table;
+
+    /**
+     * @brief Fail if the pending escrow could not be issued under the max supply
+     *
+     * put() defers issuance, so the token contract's own cap check would
+     * only fire at issueepoch() or withdraw(), after the anchors were
+     * accepted. Checking here rejects the submission instead. Costs one
+     * cross-contract read of the token's stat row per put() and one per
+     * putbatch() (not per anchor); skipped while no escrow is unissued.
+     */
+    void check_supply_cap(const global_state& g) const {
+        if (g.unissued_escrow == 0) return;
+
+        stats_table statstable(g.token_contract, g.token_symbol.code().raw());
+        PERF_ADD(rows_read, 1);
+        auto itr = statstable.find(g.token_symbol.code().raw());
+        check(itr != statstable.end(), "Token not found on token contract");
+        uint64_t headroom = static_cast<uint64_t>(itr->max_supply.amount - itr->supply.amount);
+        check(g.unissued_escrow <= headroom, "Escrow would exceed the token's max supply");
+    }
+
     /**
      * @brief Convert checksum256 to hex string
      */
     std::string checksum_to_hex(const checksum256& hash) const {
         auto hash_data = hash.extract_as_byte_array();
-        const char* hex_chars = "0123456789abcdef";
-        std::string result;
-        result.reserve(64);
-
-        for(size_t i = 0; i < hash_data.size(); i++) {
-            result += hex_chars[(hash_data[i] >> 4) & 0xF];
-            result += hex_chars[hash_data[i] & 0xF];
-        }
-
-        return result;
+        return polaris_core::to_hex(hash_data.data(), hash_data.size());
     }
 
     /**
-     * @brief Emit anchor event for off-chain indexers
+     * @brief Emit a notification action for off-chain indexers
      *
-     * Sends an inline notification action that indexers can monitor.
-     * This allows off-chain systems to track new anchors in real-time.
+     * Sends an inline action to one of this contract's notification
+     * actions (anchorevent, voteevent, finalevent, ...). Indexers read
+     * the arguments from the action trace, so state can be rebuilt
+     * without decoding table deltas.
      *
-     * @param author - Account that created the anchor
-     * @param type - Event type code
-     * @param hash - SHA256 hash of the event
-     * @param anchor_id - Auto-incrementing anchor ID
-     * @param submission_number - Global submission counter
+     * @param event - Notification action name
+     * @param args - Arguments in the notification action's parameter order
      */
-    void emit_anchor_event(name author, uint8_t type, checksum256 hash,
-                          uint64_t anchor_id, uint64_t submission_number) {
+    template<typename... Args>
+    void notify(name event, const Args&... args) {
+        PERF_ADD(inline_actions, 1);
         action(
             permission_level{get_self(), "active"_n},
             get_self(),
-            "anchorevent"_n,
-            std::make_tuple(author, type, hash, anchor_id, submission_number)
+            event,
+            std::make_tuple(args...)
         ).send();
     }
 
@@ -2023,19 +4613,8 @@ private:
      * @param token_contract - Account to validate as token contract
      */
     void validate_token_contract(name token_contract, symbol token_sym) {
-        // Define the stat table structure (from eosio.token standard)
-        struct [[eosio::table]] currency_stats {
-            asset    supply;
-            asset    max_supply;
-            name     issuer;
-
-            uint64_t primary_key() const { return supply.symbol.code().raw(); }
-        };
-
-        typedef eosio::multi_index<"stat"_n, currency_stats> stats;
-
         // Access the stat table scoped by the symbol code
-        stats statstable(token_contract, token_sym.code().raw());
+        stats_table statstable(token_contract, token_sym.code().raw());
 
         auto itr = statstable.find(token_sym.code().raw());
         check(itr != statstable.end(),
@@ -2055,7 +4634,7 @@ private:
     /**
      * @brief Read token balance from an eosio.token-compatible accounts table
      */
-    asset get_token_balance(name token_contract, name owner, symbol_code sym) const {
+    asset get_token_balance(name token_contract, name owner, symbol sym) const {
         struct [[eosio::table]] account {
             asset balance;
             uint64_t primary_key() const { return balance.symbol.code().raw(); }
@@ -2063,12 +4642,454 @@ private:
         typedef eosio::multi_index<"accounts"_n, account> accounts_table;
 
         accounts_table accts(token_contract, owner.value);
-        auto itr = accts.find(sym.raw());
+        auto itr = accts.find(sym.code().raw());
         if (itr == accts.end()) {
-            // No row means zero balance; construct zero asset with configured symbol
-            auto g = get_globals();
-            return asset(0, g.token_symbol);
+            // No row means zero balance
+            return asset(0, sym);
         }
         return itr->balance;
     }
+
+    // ============ SCHEMA MIGRATION ============
+
+    /**
+     * @brief Abort while migrate() has yet to convert rows an action depends on
+     *
+     * No-op once the schema is current, so a migrated chain pays no extra
+     * read.
+     *
+     * @param step - Last migrate() step the caller needs finished
+     */
+    void require_migrated(const global_state& g, uint8_t step) const {
+        if (g.schema_version >= SCHEMA_VERSION) return;
+
+        migration_singleton migration(get_self(), get_self().value);
+        PERF_ADD(rows_read, 1);
+        check(migration.get_or_default().step > step, "Schema migration in progress - call migrate() until it returns 0");
+    }
+
+    /**
+     * @brief Migrate step 1: copy the schema 1 globals into globals2
+     *
+     * Anchor IDs were assigned in order from 0, so the next free one is
+     * the seq the next put() should use. The legacy double carry is
+     * folded into carry_q32. total_staked, open_anchors,
+     * open_escrow and settled_votes start at zero and are counted by the
+     * steps that convert the rows behind them.
+     */
+    global_state migrate_globals(legacy_globals_singleton& legacy) {
+        PERF_ADD(rows_read, 1);
+        legacy_global_state old = legacy.get();
+
+        global_state g;
+        g.x = old.x;
+        // The floating-point carry becomes Q32.32 here, once. carry_q32 has
+        // 32 integer bits, so a whole-unit part is kept and minted by the
+        // next emitting put() (mint_with_carry) rather than masked off.
+        if (old.carry > 0.0) {
+            double carry = std::min(old.carry, double(polaris_core::Q32_FRACTION_MASK));
+            g.carry_q32 = static_cast<uint64_t>(carry * 4294967296.0);
+        }
+        g.carry = 0.0;
+        g.round = old.round;
+        g.fractally_oracle = old.fractally_oracle;
+        g.token_contract = old.token_contract;
+        g.token_symbol = old.token_symbol;
+        g.council_account = old.council_account;
+        g.approval_threshold_bp = old.approval_threshold_bp;
+        g.max_vote_weight = old.max_vote_weight;
+        g.attestor_respect_threshold = old.attestor_respect_threshold;
+        g.paused = old.paused;
+        g.vote_window_release = old.vote_window_release;
+        g.vote_window_mint = old.vote_window_mint;
+        g.vote_window_resolve = old.vote_window_resolve;
+        g.vote_window_claim = old.vote_window_claim;
+        g.vote_window_merge = old.vote_window_merge;
+        g.vote_window_default = old.vote_window_default;
+        g.multiplier_release = old.multiplier_release;
+        g.multiplier_mint = old.multiplier_mint;
+        g.multiplier_resolve = old.multiplier_resolve;
+        g.multiplier_add_claim = old.multiplier_add_claim;
+        g.multiplier_edit_claim = old.multiplier_edit_claim;
+        g.multiplier_merge = old.multiplier_merge;
+        g.approved_author_pct = old.approved_author_pct;
+        g.approved_voters_pct = old.approved_voters_pct;
+        g.approved_stakers_pct = old.approved_stakers_pct;
+        g.rejected_voters_pct = old.rejected_voters_pct;
+        g.rejected_stakers_pct = old.rejected_stakers_pct;
+
+        legacy_anchors_table anchors(get_self(), get_self().value);
+        g.anchor_count = anchors.available_primary_key();
+        g.schema_version = LEGACY_SCHEMA_VERSION;
+
+        PERF_ADD(rows_written, 1);
+        legacy.remove();
+        return g;
+    }
+
+    /**
+     * @brief Migrate step 2: copy Respect values into respect2
+     *
+     * @return true once the old table is empty
+     */
+    bool migrate_respect(uint32_t& budget) {
+        legacy_respect_table legacy(get_self(), get_self().value);
+        respect_table respect(get_self(), get_self().value);
+        auto itr = legacy.begin();
+        for (; itr != legacy.end() && budget > 0; --budget) {
+            PERF_ADD(rows_read, 1);
+            if (respect.find(itr->account.value) == respect.end()) {
+                PERF_ADD(rows_written, 1);
+                respect.emplace(get_self(), [&](auto& r) {
+                    r.account = itr->account;
+                    r.respect = itr->respect;
+                    r.round = itr->round;
+                    r.updated_at = itr->updated_at;
+                    PERF_RAM(r);
+                });
+            }
+            PERF_ADD(rows_written, 1);
+            itr = legacy.erase(itr);
+        }
+        return itr == legacy.end();
+    }
+
+    /**
+     * @brief Migrate step 3: rekey stake positions into stakes2
+     *
+     * stakernodes has one row per position, so it lists every account
+     * scope to convert. Each position starts earning from the current
+     * accumulator; nothing was distributed through it before this build.
+     * Once stakernodes is empty the old, surrogate-keyed nodeagg rows
+     * are dropped, since nodeagg2 was rebuilt from the positions.
+     *
+     * @return true once stakernodes and the old nodeagg are empty
+     */
+    bool migrate_stakes(global_state& g, uint32_t& budget) {
+        legacy_staker_nodes_table staker_nodes(get_self(), get_self().value);
+        nodeagg_table aggregates(get_self(), get_self().value);
+        auto itr = staker_nodes.begin();
+        for (; itr != staker_nodes.end() && budget > 0; --budget) {
+            PERF_ADD(rows_read, 1);
+            PERF_ADD(stakers_iterated, 1);
+            name account = itr->account;
+            checksum256 node_id = itr->node_id;
+
+            legacy_stakes_table legacy_stakes(get_self(), account.value);
+            auto by_node = legacy_stakes.get_index<"bynode"_n>();
+            auto legacy_itr = by_node.find(node_id);
+            if (legacy_itr != by_node.end()) {
+                stakes_table stakes(get_self(), account.value);
+                auto stake_probe = probe_hash_key(stakes, node_id, &stake_record::node_id);
+                if (stake_probe.first == stakes.end()) {
+                    asset amount = legacy_itr->amount;
+                    PERF_ADD(rows_written, 1);
+                    stakes.emplace(get_self(), [&](auto& s) {
+                        s.id = stake_probe.second;
+                        s.node_id = node_id;
+                        s.amount = amount;
+                        s.staked_at = legacy_itr->staked_at;
+                        s.last_updated = legacy_itr->last_updated;
+                        s.reward_snapshot = g.reward_per_stake;
+                        PERF_RAM(s);
+                    });
+
+                    auto agg_probe = probe_hash_key(aggregates, node_id, &node_aggregate::node_id);
+                    if (agg_probe.first == aggregates.end()) {
+                        PERF_ADD(rows_written, 1);
+                        aggregates.emplace(get_self(), [&](auto& a) {
+                            a.id = agg_probe.second;
+                            a.node_id = node_id;
+                            a.total = amount;
+                            a.staker_count = 1;
+                            PERF_RAM(a);
+                        });
+                    } else {
+                        PERF_ADD(rows_written, 1);
+                        aggregates.modify(agg_probe.first, same_payer, [&](auto& a) {
+                            a.total += amount;
+                            a.staker_count += 1;
+                        });
+                    }
+                    g.total_staked += amount.amount;
+                }
+                PERF_ADD(rows_written, 1);
+                by_node.erase(legacy_itr);
+            }
+            PERF_ADD(rows_written, 1);
+            itr = staker_nodes.erase(itr);
+        }
+        if (itr != staker_nodes.end()) return false;
+
+        legacy_nodeagg_table legacy_aggs(get_self(), get_self().value);
+        auto agg_itr = legacy_aggs.begin();
+        for (; agg_itr != legacy_aggs.end() && budget > 0; --budget) {
+            PERF_ADD(rows_written, 1);
+            agg_itr = legacy_aggs.erase(agg_itr);
+        }
+        return agg_itr == legacy_aggs.end();
+    }
+
+    /**
+     * @brief Migrate step 4: rekey anchors into anchors2 and anchorstate
+     *
+     * Walks the old anchors in ID order, which is submission order, so an
+     * anchor's old ID becomes its seq and a parent is always converted
+     * before its replies. Adds the tag and thread index rows the old
+     * layout did not have and moves the tally to the anchor's new ID.
+     * A backfilled reply's last_child_at uses the reply's own timestamp,
+     * the closest record of when it was anchored.
+     *
+     * @return true once the old anchors table is empty
+     */
+    bool migrate_anchors(global_state& g, uint32_t& budget) {
+        legacy_anchors_table legacy(get_self(), get_self().value);
+        legacy_votetally_table legacy_tallies(get_self(), get_self().value);
+        anchors_table anchors(get_self(), get_self().value);
+        anchorstate_table states(get_self(), get_self().value);
+        votetally_table tallies(get_self(), get_self().value);
+
+        auto itr = legacy.begin();
+        for (; itr != legacy.end() && budget > 0; --budget) {
+            PERF_ADD(rows_read, 1);
+            const legacy_anchor& old = *itr;
+            auto anchor_probe = probe_hash_key(states, old.hash, &anchor_state::hash);
+            bool convert = (anchor_probe.first == states.end());
+            uint64_t anchor_id = anchor_probe.second;
+
+            if (convert) {
+                PERF_ADD(rows_written, 1);
+                anchors.emplace(get_self(), [&](auto& a) {
+                    a.id = anchor_id;
+                    a.seq = old.id;
+                    a.author = old.author;
+                    a.type = old.type;
+                    a.hash = old.hash;
+                    a.event_cid = old.event_cid;
+                    a.parent = old.parent;
+                    a.ts = old.ts;
+                    a.tags = old.tags;
+                    PERF_RAM(a);
+                });
+
+                if (old.parent.has_value()) {
+                    auto parent_itr = find_anchor_state(states, old.parent.value());
+                    if (parent_itr != states.end()) {
+                        children_table children(get_self(), parent_itr->anchor_id);
+                        PERF_ADD(rows_written, 1);
+                        children.emplace(get_self(), [&](auto& c) {
+                            c.seq = old.id;
+                            c.anchor_id = anchor_id;
+                            PERF_RAM(c);
+                        });
+                        PERF_ADD(rows_written, 1);
+                        states.modify(parent_itr, same_payer, [&](auto& st) {
+                            st.child_count += 1;
+                            st.last_child_at = std::max(st.last_child_at, old.ts);
+                        });
+                    }
+                }
+
+                for (const auto& tag : old.tags) {
+                    tagindex_table tag_rows(get_self(), tag.value);
+                    if (tag_rows.find(old.id) == tag_rows.end()) {
+                        PERF_ADD(rows_written, 1);
+                        tag_rows.emplace(get_self(), [&](auto& t) {
+                            t.seq = old.id;
+                            t.anchor_id = anchor_id;
+                            PERF_RAM(t);
+                        });
+                    }
+                }
+
+                PERF_ADD(rows_written, 1);
+                states.emplace(get_self(), [&](auto& st) {
+                    st.anchor_id = anchor_id;
+                    st.hash = old.hash;
+                    st.author = old.author;
+                    st.type = old.type;
+                    st.expires_at = old.expires_at;
+                    st.finalized = old.finalized;
+                    st.escrowed_amount = old.finalized ? 0 : old.escrowed_amount;
+                    st.submission_x = old.submission_x;
+                    PERF_RAM(st);
+                });
+
+                if (!old.finalized) {
+                    g.open_anchors += 1;
+                    g.open_escrow += old.escrowed_amount;
+                }
+            }
+
+            auto tally_itr = legacy_tallies.find(old.id);
+            if (tally_itr != legacy_tallies.end()) {
+                PERF_ADD(rows_read, 1);
+                if (convert) {
+                    PERF_ADD(rows_written, 1);
+                    tallies.emplace(get_self(), [&](auto& t) {
+                        t.anchor_id = anchor_id;
+                        t.tx_hash = tally_itr->tx_hash;
+                        t.up_weight = tally_itr->up_weight;
+                        t.down_weight = tally_itr->down_weight;
+                        t.up_voter_count = tally_itr->up_voter_count;
+                        t.down_voter_count = tally_itr->down_voter_count;
+                        t.updated_at = tally_itr->updated_at;
+                        PERF_RAM(t);
+                    });
+                    if (old.finalized) {
+                        g.settled_votes += uint64_t(tally_itr->up_voter_count) + tally_itr->down_voter_count;
+                    }
+                }
+                PERF_ADD(rows_written, 1);
+                legacy_tallies.erase(tally_itr);
+            }
+
+            PERF_ADD(rows_written, 1);
+            itr = legacy.erase(itr);
+        }
+        return itr == legacy.end();
+    }
+
+    /**
+     * @brief Migrate step 5: move contract-scoped attestations into anchor scopes
+     *
+     * Rows of anchors that no longer exist are just erased.
+     *
+     * @return true once the old table is empty
+     */
+    bool migrate_attestations(uint32_t& budget) {
+        legacy_attestations_table legacy(get_self(), get_self().value);
+        anchorstate_table states(get_self(), get_self().value);
+        auto itr = legacy.begin();
+        for (; itr != legacy.end() && budget > 0; --budget) {
+            PERF_ADD(rows_read, 1);
+            auto state_itr = find_anchor_state(states, itr->tx_hash);
+            if (state_itr != states.end()) {
+                attestations_table attestations(get_self(), state_itr->anchor_id);
+                if (attestations.find(itr->attestor.value) == attestations.end()) {
+                    PERF_ADD(rows_written, 1);
+                    attestations.emplace(get_self(), [&](auto& a) {
+                        a.attestor = itr->attestor;
+                        a.ts = itr->ts;
+                        PERF_RAM(a);
+                    });
+                    PERF_ADD(rows_written, 1);
+                    states.modify(state_itr, same_payer, [&](auto& st) {
+                        st.attestation_count += 1;
+                    });
+                }
+            }
+            PERF_ADD(rows_written, 1);
+            itr = legacy.erase(itr);
+        }
+        return itr == legacy.end();
+    }
+
+    /**
+     * @brief Migrate step 6: move the votes of open anchors into anchor scopes
+     *
+     * Votes on finalized anchors were paid when the anchor settled and
+     * carry nothing claimable, so they are only erased. Neutral votes
+     * never had a row in the new layout.
+     *
+     * @return true once the old table is empty
+     */
+    bool migrate_votes(uint32_t& budget) {
+        legacy_votes_table legacy(get_self(), get_self().value);
+        anchorstate_table states(get_self(), get_self().value);
+        auto itr = legacy.begin();
+        for (; itr != legacy.end() && budget > 0; --budget) {
+            PERF_ADD(rows_read, 1);
+            PERF_ADD(voters_iterated, 1);
+            auto state_itr = find_anchor_state(states, itr->tx_hash);
+            if (state_itr != states.end() && !state_itr->finalized && itr->val != 0) {
+                votes_table votes(get_self(), state_itr->anchor_id);
+                if (votes.find(itr->voter.value) == votes.end()) {
+                    PERF_ADD(rows_written, 1);
+                    votes.emplace(get_self(), [&](auto& v) {
+                        v.voter = itr->voter;
+                        v.val = itr->val;
+                        v.weight = itr->weight;
+                        v.ts = itr->ts;
+                        PERF_RAM(v);
+                    });
+                }
+            }
+            PERF_ADD(rows_written, 1);
+            itr = legacy.erase(itr);
+        }
+        return itr == legacy.end();
+    }
+
+    /**
+     * @brief Migrate step 7: fold the old like counts into likeagg2
+     *
+     * The like rows behind the counts stay in the old, account-scoped
+     * likes table, which like() and unlike() also read.
+     *
+     * @return true once the old likeagg table is empty
+     */
+    bool migrate_likes(uint32_t& budget) {
+        legacy_likeagg_table legacy(get_self(), get_self().value);
+        likeagg_table aggregates(get_self(), get_self().value);
+        auto itr = legacy.begin();
+        for (; itr != legacy.end() && budget > 0; --budget) {
+            PERF_ADD(rows_read, 1);
+            auto agg_probe = probe_hash_key(aggregates, itr->node_id, &like_aggregate::node_id);
+            if (agg_probe.first == aggregates.end()) {
+                PERF_ADD(rows_written, 1);
+                aggregates.emplace(get_self(), [&](auto& a) {
+                    a.id = agg_probe.second;
+                    a.node_id = itr->node_id;
+                    a.like_count = itr->like_count;
+                    PERF_RAM(a);
+                });
+            } else {
+                PERF_ADD(rows_written, 1);
+                aggregates.modify(agg_probe.first, same_payer, [&](auto& a) {
+                    a.like_count += itr->like_count;
+                });
+            }
+            PERF_ADD(rows_written, 1);
+            itr = legacy.erase(itr);
+        }
+        return itr == legacy.end();
+    }
+
+    /**
+     * @brief Build a getanchor() result from an anchor step 4 has not reached
+     *
+     * anchor_id and seq are the schema 1 ID until the anchor is rekeyed.
+     */
+    std::optional<anchor_view> find_legacy_anchor(const checksum256& tx_hash) const {
+        legacy_anchors_table legacy(get_self(), get_self().value);
+        auto by_hash = legacy.get_index<"byhash"_n>();
+        auto itr = by_hash.find(tx_hash);
+        if (itr == by_hash.end()) return std::nullopt;
+
+        anchor_view view{};
+        view.anchor_id = itr->id;
+        view.seq = itr->id;
+        view.author = itr->author;
+        view.type = itr->type;
+        view.hash = itr->hash;
+        view.event_cid = itr->event_cid;
+        view.parent = itr->parent;
+        view.ts = itr->ts;
+        view.tags = itr->tags;
+        view.expires_at = itr->expires_at;
+        view.finalized = itr->finalized;
+        view.escrowed_amount = itr->escrowed_amount;
+        view.submission_x = itr->submission_x;
+
+        legacy_votetally_table legacy_tallies(get_self(), get_self().value);
+        auto tally_itr = legacy_tallies.find(itr->id);
+        if (tally_itr != legacy_tallies.end()) {
+            view.up_weight = tally_itr->up_weight;
+            view.down_weight = tally_itr->down_weight;
+            view.up_voter_count = tally_itr->up_voter_count;
+            view.down_voter_count = tally_itr->down_voter_count;
+        }
+        return view;
+    }
 };
@@ -0,0 +1,464 @@
+/**
+ * @file benchmark.js
+ * @brief Per-action resource benchmark for the Polaris Music Registry contract
+ *
+ * Pushes real transactions to a local test chain (same setup as
+ * polaris.test.js) and records, for every measured action:
+ * - cpu_usage_us and net bytes from the transaction receipt
+ * - RAM delta summed over the action and all of its inline actions
+ *
+ * Parameters are swept so costs can be read as a function of table size:
+ * voters per anchor, stakers per node, nodes per staker and batch sizes.
+ *
+ * Voting windows are at least one hour, so the run is split in phases:
+ *   node benchmark.js run              anchoring, voting, staking, likes;
+ *                                      leaves settlement fixtures in BENCH_STATE
+ *   node benchmark.js settle           finalize/crank/claimvote on those fixtures
+ *                                      (once their voting windows have closed)
+ *   node benchmark.js compare a.json b.json
+ *                                      per-measurement diff of two reports
+ *
+ * Configuration (environment):
+ *   RPC_ENDPOINT    chain RPC (default http://127.0.0.1:8888)
+ *   BENCH_VOTERS    voters per anchor sweep (default 1,10,50)
+ *   BENCH_STAKERS   stakers per node sweep (default 1,10,50)
+ *   BENCH_NODES     nodes per staker sweep (default 1,10,25)
+ *   BENCH_BATCH     putbatch/votebatch/crank size sweep (default 1,10,25,50)
+ *   BENCH_OUT       report file (default bench-report.json)
+ *   BENCH_STATE     fixture file shared by run and settle (default bench-state.json)
+ */
+
+const { Api, JsonRpc } = require('eosjs');
+const { JsSignatureProvider } = require('eosjs/dist/eosjs-jssig');
+const fetch = require('node-fetch');
+const { TextEncoder, TextDecoder } = require('util');
+const crypto = require('crypto');
+const fs = require('fs');
+
+// Benchmark configuration (accounts match polaris.test.js)
+const CONTRACT_ACCOUNT = 'polaris';
+const ORACLE_ACCOUNT = 'oracle';
+const TOKEN_CONTRACT = 'eosio.token';
+const RPC_ENDPOINT = process.env.RPC_ENDPOINT || 'http://127.0.0.1:8888';
+
+// Local development key (NEVER use in production!)
+const DEV_PRIVATE_KEY = '5KQwrPbwdL6PhXujxW37FSSQZ1JiwsST4cqQzDeyXtP79zkvFD3';
+const DEV_PUBLIC_KEY = 'EOS6MRyAjQq8ud7hVNYcfnVPJqcVpscN5So8BhtHuGYqET5GDW5CV';
+
+const ADD_CLAIM = 30;  // Content type: mints escrow, no attestation needed
+
+function parseList(value, fallback) {
+    if (!value) return fallback;
+    return value.split(',').map(v => parseInt(v, 10)).filter(v => v > 0);
+}
+
+const SWEEP = {
+    voters: parseList(process.env.BENCH_VOTERS, [1, 10, 50]),
+    stakers: parseList(process.env.BENCH_STAKERS, [1, 10, 50]),
+    nodes: parseList(process.env.BENCH_NODES, [1, 10, 25]),
+    batch: parseList(process.env.BENCH_BATCH, [1, 10, 25, 50])
+};
+
+const REPORT_FILE = process.env.BENCH_OUT || 'bench-report.json';
+const STATE_FILE = process.env.BENCH_STATE || 'bench-state.json';
+
+const rpc = new JsonRpc(RPC_ENDPOINT, { fetch });
+const api = new Api({
+    rpc,
+    signatureProvider: new JsSignatureProvider([DEV_PRIVATE_KEY]),
+    textDecoder: new TextDecoder(),
+    textEncoder: new TextEncoder()
+});
+
+const results = [];
+const runTag = crypto.randomBytes(4).toString('hex');
+
+// ============ HELPERS ============
+
+function sha256(data) {
+    return crypto.createHash('sha256').update(data).digest('hex');
+}
+
+function now() {
+    return Math.floor(Date.now() / 1000);
+}
+
+/**
+ * Deterministic benchmark account name: prefix + index in the name alphabet
+ */
+function benchAccount(prefix, index) {
+    const alphabet = '12345abcdefghijklmnopqrstuvwxyz';
+    let suffix = '';
+    let n = index;
+    do {
+        suffix = alphabet[n % alphabet.length] + suffix;
+        n = Math.floor(n / alphabet.length);
+    } while (n > 0);
+    return prefix + suffix.padStart(4, '1');
+}
+
+function contractAction(name, actor, data) {
+    return {
+        account: CONTRACT_ACCOUNT,
+        name,
+        authorization: [{ actor, permission: 'active' }],
+        data
+    };
+}
+
+/**
+ * Walk an action trace list (flat or nested) and sum RAM deltas
+ */
+function sumRamDeltas(traces) {
+    let total = 0;
+    for (const trace of traces || []) {
+        for (const delta of trace.account_ram_deltas || []) {
+            total += delta.delta;
+        }
+        total += sumRamDeltas(trace.inline_traces);
+    }
+    return total;
+}
+
+async function transact(actions) {
+    return api.transact({ actions }, { blocksBehind: 3, expireSeconds: 30 });
+}
+
+/**
+ * Push a transaction and record its resource usage under action + params
+ */
+async function measure(action, params, actions) {
+    const started = Date.now();
+    const result = await transact(actions);
+    const processed = result.processed || {};
+    const receipt = processed.receipt || {};
+
+    const row = {
+        action,
+        params,
+        cpu_us: receipt.cpu_usage_us,
+        net_bytes: (receipt.net_usage_words || 0) * 8,
+        ram_delta_bytes: sumRamDeltas(processed.action_traces),
+        elapsed_us: processed.elapsed,
+        wall_ms: Date.now() - started
+    };
+    results.push(row);
+    console.log(`${action.padEnd(12)} ${JSON.stringify(params).padEnd(28)} ` +
+                `cpu=${row.cpu_us}us net=${row.net_bytes}B ram=${row.ram_delta_bytes}B`);
+    return result;
+}
+
+async function accountExists(account) {
+    try {
+        await rpc.get_account(account);
+        return true;
+    } catch (e) {
+        return false;
+    }
+}
+
+/**
+ * Create benchmark accounts whose active permission also trusts
+ * polaris@eosio.code (stake() pulls tokens with an inline transfer)
+ */
+async function ensureAccounts(accounts) {
+    let systemContract = false;
+    try {
+        const abi = await rpc.get_abi('eosio');
+        systemContract = !!(abi.abi && abi.abi.actions.find(a => a.name === 'buyrambytes'));
+    } catch (e) {
+        systemContract = false;
+    }
+
+    const keyAuth = { threshold: 1, keys: [{ key: DEV_PUBLIC_KEY, weight: 1 }], accounts: [], waits: [] };
+    const activeAuth = {
+        ...keyAuth,
+        accounts: [{ permission: { actor: CONTRACT_ACCOUNT, permission: 'eosio.code' }, weight: 1 }]
+    };
+
+    for (const account of accounts) {
+        if (await accountExists(account)) continue;
+
+        const actions = [{
+            account: 'eosio',
+            name: 'newaccount',
+            authorization: [{ actor: 'eosio', permission: 'active' }],
+            data: { creator: 'eosio', name: account, owner: keyAuth, active: activeAuth }
+        }];
+        if (systemContract) {
+            actions.push({
+                account: 'eosio',
+                name: 'buyrambytes',
+                authorization: [{ actor: 'eosio', permission: 'active' }],
+                data: { payer: 'eosio', receiver: account, bytes: 65536 }
+            });
+        }
+        await transact(actions);
+    }
+}
+
+async function getGlobals() {
+    const resp = await rpc.get_table_rows({
+        json: true, code: CONTRACT_ACCOUNT, scope: CONTRACT_ACCOUNT, table: 'globals2', limit: 1
+    });
+    if (!resp.rows.length) {
+        throw new Error('Contract not initialized - deploy and init polaris first (see README.md)');
+    }
+    return resp.rows[0];
+}
+
+async function grantRespect(accounts, value) {
+    const g = await getGlobals();
+    let round = Number(g.round);
+    for (let i = 0; i < accounts.length; i += 1000) {
+        round += 1;
+        await transact([contractAction('updrespect', ORACLE_ACCOUNT, {
+            respect_data: accounts.slice(i, i + 1000).map(a => ({ first: a, second: value })),
+            election_round: round
+        })]);
+    }
+}
+
+/**
+ * Format a whole number of tokens for a "precision,CODE" symbol
+ */
+function tokenQuantity(symbol, tokens) {
+    const [precision, code] = symbol.split(',');
+    return tokens.toFixed(Number(precision)) + ' ' + code;
+}
+
+/**
+ * Give every account `tokens` whole tokens
+ */
+async function fundAccounts(accounts, symbol, tokens) {
+    const quantity = tokenQuantity(symbol, tokens);
+    const total = tokenQuantity(symbol, tokens * accounts.length);
+
+    // polaris is the token issuer (see deploy-token.sh)
+    await transact([{
+        account: TOKEN_CONTRACT,
+        name: 'issue',
+        authorization: [{ actor: CONTRACT_ACCOUNT, permission: 'active' }],
+        data: { to: CONTRACT_ACCOUNT, quantity: total, memo: 'benchmark funding' }
+    }]);
+    for (const account of accounts) {
+        await transact([{
+            account: TOKEN_CONTRACT,
+            name: 'transfer',
+            authorization: [{ actor: CONTRACT_ACCOUNT, permission: 'active' }],
+            data: { from: CONTRACT_ACCOUNT, to: account, quantity, memo: 'benchmark funding' }
+        }]);
+    }
+}
+
+function anchorInput(label) {
+    return {
+        type: ADD_CLAIM,
+        hash: sha256(`bench-${runTag}-${label}`),
+        event_cid: `bafybench${runTag}${label}`.slice(0, 100),
+        parent: null,
+        ts: now(),
+        tags: []
+    };
+}
+
+async function putAnchor(author, label, record) {
+    const input = anchorInput(label);
+    const actions = [contractAction('put', author, { author, ...input })];
+    if (record) {
+        await measure('put', {}, actions);
+    } else {
+        await transact(actions);
+    }
+    return input.hash;
+}
+
+function writeReport(phase) {
+    let report = { contract: CONTRACT_ACCOUNT, rpc: RPC_ENDPOINT, sweep: SWEEP, results: [] };
+    if (phase === 'settle' && fs.existsSync(REPORT_FILE)) {
+        report = JSON.parse(fs.readFileSync(REPORT_FILE, 'utf8'));
+    }
+    report[`${phase}_at`] = new Date().toISOString();
+    report.results = report.results.concat(results);
+    fs.writeFileSync(REPORT_FILE, JSON.stringify(report, null, 2));
+    console.log(`\nWrote ${results.length} measurements to ${REPORT_FILE}`);
+}
+
+// ============ PHASES ============
+
+async function runPhase() {
+    const g = await getGlobals();
+    const maxAccounts = Math.max(...SWEEP.voters, ...SWEEP.stakers, 1);
+    const accounts = Array.from({ length: maxAccounts }, (_, i) => benchAccount('bench', i));
+    const author = accounts[0];
+
+    console.log(`Preparing ${accounts.length} benchmark accounts`);
+    await ensureAccounts(accounts);
+    await grantRespect(accounts, 10);
+
+    const state = { run_tag: runTag, created_at: now(), finalize: [], crank: [], claim: null };
+
+    // Anchoring: single put, then putbatch by batch size
+    await putAnchor(author, 'put-single', true);
+    for (const size of SWEEP.batch) {
+        const anchors = Array.from({ length: size }, (_, i) => anchorInput(`batch-${size}-${i}`));
+        await measure('putbatch', { batch: size }, [contractAction('putbatch', author, { author, anchors })]);
+    }
+
+    // Voting: one vote on an anchor that already has N voters, and settlement fixtures
+    for (const voters of SWEEP.voters) {
+        for (const side of [1, -1]) {
+            const hash = await putAnchor(author, `vote-${voters}-${side}`, false);
+            for (let i = 0; i < voters; i++) {
+                const actions = [contractAction('vote', accounts[i], { voter: accounts[i], tx_hash: hash, val: side })];
+                if (i === voters - 1) {
+                    await measure('vote', { voters, side }, actions);
+                } else {
+                    await transact(actions);
+                }
+            }
+            state.finalize.push({ hash, voters, side });
+            if (side === 1 && !state.claim) state.claim = { hash, voter: accounts[0] };
+        }
+    }
+
+    for (const size of SWEEP.batch) {
+        const votes = [];
+        for (let i = 0; i < size; i++) {
+            votes.push({ first: await putAnchor(author, `votebatch-${size}-${i}`, false), second: 1 });
+        }
+        await measure('votebatch', { batch: size },
+                      [contractAction('votebatch', accounts[0], { voter: accounts[0], votes })]);
+    }
+
+    // Unvoted anchors for crank sweeps (settled in the settle phase)
+    for (const size of SWEEP.batch) {
+        for (let i = 0; i < size; i++) {
+            await putAnchor(author, `crank-${size}-${i}`, false);
+        }
+        state.crank.push(size);
+    }
+
+    // Staking: cost of stake/unstake/claimreward with N stakers on the node
+    const stakeQuantity = tokenQuantity(g.token_symbol, 1);
+    await fundAccounts(accounts, g.token_symbol, Math.max(...SWEEP.nodes) + 2);
+    for (const stakers of SWEEP.stakers) {
+        const node = sha256(`bench-node-${runTag}-${stakers}`);
+        for (let i = 0; i < stakers; i++) {
+            const actions = [contractAction('stake', accounts[i], { account: accounts[i], node_id: node, quantity: stakeQuantity })];
+            if (i === stakers - 1) {
+                await measure('stake', { stakers }, actions);
+            } else {
+                await transact(actions);
+            }
+        }
+        await measure('unstake', { stakers }, [contractAction('unstake', accounts[0],
+                      { account: accounts[0], node_id: node, quantity: stakeQuantity })]);
+    }
+
+    // Node count: one account staked on N nodes, then claimall over every position
+    const whale = accounts[accounts.length - 1];
+    let staked = 0;
+    for (const nodes of SWEEP.nodes) {
+        for (; staked < nodes; staked++) {
+            await transact([contractAction('stake', whale, {
+                account: whale, node_id: sha256(`bench-whale-${runTag}-${staked}`), quantity: stakeQuantity
+            })]);
+        }
+        try {
+            await measure('claimall', { nodes }, [contractAction('claimall', whale, {
+                account: whale, max_rows: Math.min(nodes, 100)
+            })]);
+        } catch (e) {
+            // Nothing accrued yet (no rejected anchor since staking)
+            console.log(`claimall     ${JSON.stringify({ nodes })} skipped: ${e.message.split('\n')[0]}`);
+        }
+    }
+
+    // Likes with a path of N nodes
+    for (const length of [1, 10, 20]) {
+        const path = Array.from({ length }, (_, i) => sha256(`bench-path-${runTag}-${length}-${i}`));
+        await measure('like', { path: length }, [contractAction('like', author, {
+            account: author, node_id: path[path.length - 1], node_path: path
+        })]);
+    }
+
+    const window = Number(g.vote_window_claim);
+    state.settle_after = now() + window;
+    fs.writeFileSync(STATE_FILE, JSON.stringify(state, null, 2));
+    writeReport('run');
+    console.log(`Settlement fixtures saved to ${STATE_FILE}; run "node benchmark.js settle" ` +
+                `after ${new Date(state.settle_after * 1000).toISOString()}`);
+}
+
+async function settlePhase() {
+    if (!fs.existsSync(STATE_FILE)) {
+        throw new Error(`${STATE_FILE} not found - run "node benchmark.js run" first`);
+    }
+    const state = JSON.parse(fs.readFileSync(STATE_FILE, 'utf8'));
+    const info = await rpc.get_info();
+    const headTime = Math.floor(Date.parse(info.head_block_time + 'Z') / 1000);
+    if (headTime < state.settle_after) {
+        console.log(`Voting windows still open for ${state.settle_after - headTime}s`);
+        process.exitCode = 1;
+        return;
+    }
+
+    for (const fixture of state.finalize) {
+        await measure('finalize', { voters: fixture.voters, side: fixture.side },
+                      [contractAction('finalize', ORACLE_ACCOUNT, { tx_hash: fixture.hash })]);
+    }
+
+    if (state.claim) {
+        await measure('claimvote', {}, [contractAction('claimvote', state.claim.voter,
+                      { voter: state.claim.voter, tx_hash: state.claim.hash })]);
+    }
+
+    // crank settles the oldest expired anchors, whichever fixture they belong to
+    for (const size of state.crank) {
+        try {
+            await measure('crank', { batch: size }, [contractAction('crank', ORACLE_ACCOUNT, { max_items: size })]);
+        } catch (e) {
+            console.log(`crank        ${JSON.stringify({ batch: size })} skipped: ${e.message.split('\n')[0]}`);
+        }
+    }
+
+    writeReport('settle');
+    fs.unlinkSync(STATE_FILE);
+}
+
+function comparePhase(baseFile, nextFile) {
+    const key = r => `${r.action} ${JSON.stringify(r.params)}`;
+    const base = new Map(JSON.parse(fs.readFileSync(baseFile, 'utf8')).results.map(r => [key(r), r]));
+    const next = JSON.parse(fs.readFileSync(nextFile, 'utf8')).results;
+
+    const pct = (a, b) => (a ? (((b - a) / a) * 100).toFixed(1) + '%' : 'n/a');
+    for (const r of next) {
+        const b = base.get(key(r));
+        if (!b) {
+            console.log(`${key(r).padEnd(42)} new`);
+            continue;
+        }
+        console.log(`${key(r).padEnd(42)} cpu ${b.cpu_us} -> ${r.cpu_us} (${pct(b.cpu_us, r.cpu_us)})  ` +
+                    `net ${b.net_bytes} -> ${r.net_bytes}  ram ${b.ram_delta_bytes} -> ${r.ram_delta_bytes}`);
+    }
+}
+
+async function main() {
+    const phase = process.argv[2] || 'run';
+    if (phase === 'run') {
+        await runPhase();
+    } else if (phase === 'settle') {
+        await settlePhase();
+    } else if (phase === 'compare') {
+        if (process.argv.length < 5) throw new Error('usage: node benchmark.js compare <base.json> <new.json>');
+        comparePhase(process.argv[3], process.argv[4]);
+    } else {
+        throw new Error(`Unknown phase "${phase}" (expected run, settle or compare)`);
+    }
+}
+
+main().catch(err => {
+    console.error(err.message || err);
+    process.exitCode = 1;
+});
@@ -7,6 +7,8 @@
  */
 
 const { expect } = require('chai');
+const fs = require('fs');
+const path = require('path');
 
 describe('Polaris Contract Validation Logic', () => {
 
@@ -57,6 +59,26 @@ describe('Polaris Contract Validation Logic', () => {
             expect(41 >= MIN_CONTENT_TYPE && 41 <= MAX_CONTENT_TYPE).to.be.false; // Like
             expect(50 >= MIN_CONTENT_TYPE && 50 <= MAX_CONTENT_TYPE).to.be.false; // Finalize
         });
+
+        it('should only open submission types to voting', () => {
+            // Read the registry itself (make_event_registry in polaris.core.hpp),
+            // so a change there is caught here rather than mirrored by hand
+            const core = fs.readFileSync(path.join(__dirname, '../../polaris.core.hpp'), 'utf8');
+            const constant = (name) => Number(core.match(new RegExp(`${name} = (\\d+);`))[1]);
+            const nonVotable = [...core.matchAll(/r\.types\[(\d+)\]\.votable = false;/g)].map(m => Number(m[1]));
+            const isContent = (type) => type >= constant('MIN_CONTENT_TYPE') && type <= constant('MAX_CONTENT_TYPE');
+
+            // VOTE, LIKE and DISCUSS records are rejected by vote(); FINALIZE too
+            expect([...nonVotable].sort((a, b) => a - b)).to.deep.equal([40, 41, 42, 50]);
+
+            // MERGE_ENTITY is votable but outside the content range
+            expect(nonVotable).to.not.include(60);
+            expect(isContent(60)).to.be.false;
+            [21, 22, 23, 30, 31].forEach(type => {
+                expect(isContent(type)).to.be.true;
+                expect(nonVotable).to.not.include(type);
+            });
+        });
     });
 
     describe('Timestamp Validation (LOW-7 fix)', () => {
@@ -281,6 +303,108 @@ describe('Polaris Contract Validation Logic', () => {
         });
     });
 
+    describe('Staker Reward Accumulator', () => {
+
+        // Mirrors distribute_to_stakers() / accrued_reward() in the contract
+        const REWARD_PRECISION = BigInt('1000000000000000000'); // 1e18
+        const UINT128_MAX = (BigInt(1) << BigInt(128)) - BigInt(1);
+
+        function accrued(amount, rewardPerStake, snapshot) {
+            return (amount * (rewardPerStake - snapshot)) / REWARD_PRECISION;
+        }
+
+        it('should match the per-node proportional split', () => {
+            // Two nodes: A has alice=300, bob=100; B has charlie=600
+            const stakes = { alice: BigInt(300), bob: BigInt(100), charlie: BigInt(600) };
+            const totalStaked = BigInt(1000);
+            const reward = BigInt(50000);
+
+            const rps = (reward * REWARD_PRECISION) / totalStaked;
+
+            // Legacy: node share = reward * node_total / total, staker share = node share * amount / node_total
+            const nodeA = (reward * BigInt(400)) / totalStaked;
+            expect(accrued(stakes.alice, rps, BigInt(0))).to.deep.equal((nodeA * stakes.alice) / BigInt(400));
+            expect(accrued(stakes.bob, rps, BigInt(0))).to.deep.equal((nodeA * stakes.bob) / BigInt(400));
+            expect(accrued(stakes.charlie, rps, BigInt(0))).to.deep.equal(reward * stakes.charlie / totalStaked);
+        });
+
+        it('should not pay rewards distributed before a position was opened', () => {
+            const first = (BigInt(1000) * REWARD_PRECISION) / BigInt(100);
+            const second = (BigInt(1000) * REWARD_PRECISION) / BigInt(200);
+
+            // Late staker snapshots the accumulator after the first distribution
+            const late = accrued(BigInt(100), first + second, first);
+            expect(late).to.deep.equal(BigInt(500));
+        });
+
+        it('should keep amount * delta within uint128 for maximum supply', () => {
+            const int64Max = BigInt('9223372036854775807');
+
+            // Worst case: entire supply distributed to a single staked unit
+            const delta = (int64Max * REWARD_PRECISION) / BigInt(1);
+            expect(BigInt(1) * delta <= UINT128_MAX).to.be.true;
+
+            // Whole supply staked by one account, whole supply distributed
+            const deltaFull = (int64Max * REWARD_PRECISION) / int64Max;
+            expect(int64Max * deltaFull <= UINT128_MAX).to.be.true;
+        });
+    });
+
+    describe('Fixed-Point Emission Curve', () => {
+        const LN2_Q64 = 12786308645202655659n;
+        const ONE_Q64 = 1n << 64n;
+
+        // Mirrors log2_q32(): integer part from the top bit, fraction by repeated squaring
+        const log2Q32 = (x) => {
+            const intPart = BigInt(x.toString(2).length - 1);
+            let y = x << (63n - intPart);
+            let frac = 0n;
+            for (let i = 31n; i >= 0n; i--) {
+                y = (y * y) >> 63n;
+                if (y >= ONE_Q64) {
+                    y >>= 1n;
+                    frac |= 1n << i;
+                }
+            }
+            return (intPart << 32n) | frac;
+        };
+
+        // Mirrors emission_q32(): m * ln(x) / x in Q32.32
+        const emissionQ32 = (m, x) => (m * ((log2Q32(x) * LN2_Q64) >> 64n)) / x;
+
+        it('should give zero emission at x = 1 and exact log2 at powers of two', () => {
+            expect(emissionQ32(1000000n, 1n)).to.equal(0n);
+            expect(log2Q32(1024n)).to.equal(10n << 32n);
+        });
+
+        it('should track the floating-point curve to Q32 resolution', () => {
+            const m = 1000000n;
+            for (const x of [2n, 3n, 10n, 12345n, 1000000n, 987654321n, 1n << 40n]) {
+                const fixed = Number(emissionQ32(m, x)) / 2 ** 32;
+                const real = Number(m) * Math.log(Number(x)) / Number(x);
+                // ln(x) is truncated to 2^-32, then scaled by m / x
+                const bound = (Number(m) / Number(x) + 1) * 2 ** -31;
+                expect(real - fixed).to.be.below(bound);
+                expect(fixed).to.be.at.most(real); // Truncation never over-mints
+            }
+        });
+
+        it('should carry the fraction so mints sum to the truncated total', () => {
+            const m = 50000n;
+            let carry = 0n;
+            let minted = 0n;
+            let exact = 0n;
+            for (let x = 2n; x < 200n; x++) {
+                const e = emissionQ32(m, x);
+                const total = e + carry;
+                minted += total >> 32n;
+                carry = total & 0xFFFFFFFFn;
+                exact += e;
+            }
+            expect(minted).to.equal(exact >> 32n);
+        });
+    });
+
     describe('Voting Window Calculations (LOW-22 fix)', () => {
 
         const SECONDS_PER_DAY = 24 * 60 * 60;